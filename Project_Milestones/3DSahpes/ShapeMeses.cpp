@@ -15,6 +15,7 @@
 #include <glm/gtx/transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <cstring>
 #include <vector>
 
 namespace
@@ -24,11 +25,103 @@ namespace
 	const GLuint g_FloatsPerVertex = 3;	// Number of coordinates per vertex
 	const GLuint g_FloatsPerNormal = 3;	// Number of values per vertex color
 	const GLuint g_FloatsPerUV = 2;		// Number of texture coordinate values
+
+	// viewer distances at which the sphere/torus draws switch to the
+	// lower-density level-of-detail meshes
+	const float g_LOD1Distance = 12.0f;
+	const float g_LOD2Distance = 25.0f;
+
+	// tessellation densities for the torus variants and the sphere
+	// level-of-detail variants
+	const int g_TorusSegments = 30;
+	const int g_TorusLOD1MainSegments = 20;
+	const int g_TorusLOD1TubeSegments = 14;
+	const int g_TorusLOD2MainSegments = 10;
+	const int g_TorusLOD2TubeSegments = 8;
+	const int g_SphereLOD1Segments = 24;
+	const int g_SphereLOD2Segments = 12;
+
+	// number of bytes per vertex when the packed vertex format is
+	// active - float position, 2_10_10_10 normal, half-float UVs
+	const GLuint g_PackedVertexBytes =
+		sizeof(GLfloat) * 3 + sizeof(GLuint) + sizeof(GLushort) * 2;
+
+	// pack one unit-length normal component into a signed 10 bit field
+	GLuint PackNormalComponent(GLfloat value)
+	{
+		if (value < -1.0f)
+		{
+			value = -1.0f;
+		}
+		if (value > 1.0f)
+		{
+			value = 1.0f;
+		}
+		return ((GLint)(value * 511.0f)) & 0x3FF;
+	}
+
+	// convert a full float into a half-float bit pattern - values too
+	// small for a half flush to zero, values too large become infinity
+	GLushort FloatToHalf(GLfloat value)
+	{
+		GLuint bits = 0;
+		memcpy(&bits, &value, sizeof(bits));
+
+		GLuint sign = (bits >> 16) & 0x8000;
+		GLint exponent = (GLint)((bits >> 23) & 0xFF) - 127 + 15;
+		GLuint mantissa = bits & 0x7FFFFF;
+
+		if (exponent <= 0)
+		{
+			return (GLushort)sign;
+		}
+		if (exponent >= 31)
+		{
+			return (GLushort)(sign | 0x7C00);
+		}
+		return (GLushort)(sign | ((GLuint)exponent << 10) | (mantissa >> 13));
+	}
+
+	// attach a debug label to a GL object so external capture tools
+	// show names instead of raw object numbers
+	void LabelGLObject(GLenum identifier, GLuint objectID, const char* label)
+	{
+		if (GLEW_KHR_debug)
+		{
+			glObjectLabel(identifier, objectID, -1, label);
+		}
+	}
 }
 
 ShapeMeshes::ShapeMeshes()
 {
 	m_bMemoryLayoutDone = false;
+	m_bPackedVertexFormat = true;
+	m_instanceVBO = 0;
+	m_instanceVBOCapacity = 0;
+	m_bConsolidated = false;
+	m_bMegaVAOBound = false;
+	m_megaVAO = 0;
+	m_megaVBO = 0;
+	m_megaIBO = 0;
+
+	// clear the mesh structures so unloaded meshes can be recognized
+	m_BoxMesh = GLMesh();
+	m_ConeMesh = GLMesh();
+	m_CylinderMesh = GLMesh();
+	m_PlaneMesh = GLMesh();
+	m_PrismMesh = GLMesh();
+	m_Pyramid3Mesh = GLMesh();
+	m_Pyramid4Mesh = GLMesh();
+	m_SphereMesh = GLMesh();
+	m_TaperedCylinderMesh = GLMesh();
+	m_SphereLOD1Mesh = GLMesh();
+	m_SphereLOD2Mesh = GLMesh();
+
+	// default tube thicknesses until the Load*TorusMesh methods run
+	m_torusThickness = 0.2f;
+	m_extraTorus1Thickness = 0.4f;
+	m_extraTorus2Thickness = 0.6f;
 }
 
 //**************************************************************************
@@ -117,7 +210,7 @@ void ShapeMeshes::LoadBoxMesh()
 	// Create 2 buffers: first one for the vertex data; second one for the indices
 	glGenBuffers(2, m_BoxMesh.vbos);
 	glBindBuffer(GL_ARRAY_BUFFER, m_BoxMesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
+	UploadVertexData(verts, m_BoxMesh.nVertices); // Sends vertex or coordinate data to the GPU
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_BoxMesh.vbos[1]); // Activates the buffer
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
@@ -131,445 +224,54 @@ void ShapeMeshes::LoadBoxMesh()
 ///////////////////////////////////////////////////
 //	LoadConeMesh()
 //
-//	Create a cole mesh by specifying the vertices and 
-//  store it in a VAO/VBO.  The normals and texture
-//  coordinates are also set.
+//	Create an indexed cone mesh and store it in a
+//  VAO/VBO.  The normals and texture coordinates
+//  are also set.
 //
 //  Correct triangle drawing commands:
 //
-//	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-//	glDrawArrays(GL_TRIANGLE_STRIP, 36, 108);	//sides
+//	glDrawElements(GL_TRIANGLES, meshes.gConeMesh.nBottomIndices, GL_UNSIGNED_INT, (void*)0);	//bottom
+//	glDrawElements(GL_TRIANGLES, meshes.gConeMesh.nSideIndices, GL_UNSIGNED_INT, (void*)(meshes.gConeMesh.nBottomIndices * sizeof(GLuint)));	//sides
 ///////////////////////////////////////////////////
 void ShapeMeshes::LoadConeMesh()
 {
-	GLfloat verts[] = {
-		// cone bottom			// normals			// texture coords
-		1.0f, 0.0f, 0.0f,		0.0f, -1.0f, 0.0f,	0.5f,1.0f,
-		.98f, 0.0f, -0.17f,		0.0f, -1.0f, 0.0f,	0.41f, 0.983f,
-		.94f, 0.0f, -0.34f,		0.0f, -1.0f, 0.0f,	0.33f, 0.96f,
-		.87f, 0.0f, -0.5f,		0.0f, -1.0f, 0.0f,	0.25f, 0.92f,
-		.77f, 0.0f, -0.64f,		0.0f, -1.0f, 0.0f,	0.17f, 0.87f,
-		.64f, 0.0f, -0.77f,		0.0f, -1.0f, 0.0f,	0.13f, 0.83f,
-		.5f, 0.0f, -0.87f,		0.0f, -1.0f, 0.0f,	0.08f, 0.77f,
-		.34f, 0.0f, -0.94f,		0.0f, -1.0f, 0.0f,	0.04f, 0.68f,
-		.17f, 0.0f, -0.98f,		0.0f, -1.0f, 0.0f,	0.017f, 0.6f,
-		0.0f, 0.0f, -1.0f,		0.0f, -1.0f, 0.0f,	0.0f,0.5f,
-		-.17f, 0.0f, -0.98f,	0.0f, -1.0f, 0.0f,	0.017f, 0.41f,
-		-.34f, 0.0f, -0.94f,	0.0f, -1.0f, 0.0f,	0.04f, 0.33f,
-		-.5f, 0.0f, -0.87f,		0.0f, -1.0f, 0.0f,	0.08f, 0.25f,
-		-.64f, 0.0f, -0.77f,	0.0f, -1.0f, 0.0f,	0.13f, 0.17f,
-		-.77f, 0.0f, -0.64f,	0.0f, -1.0f, 0.0f,	0.17f, 0.13f,
-		-.87f, 0.0f, -0.5f,		0.0f, -1.0f, 0.0f,	0.25f, 0.08f,
-		-.94f, 0.0f, -0.34f,	0.0f, -1.0f, 0.0f,	0.33f, 0.04f,
-		-.98f, 0.0f, -0.17f,	0.0f, -1.0f, 0.0f,	0.41f, 0.017f,
-		-1.0f, 0.0f, 0.0f,		0.0f, -1.0f, 0.0f,	0.5f, 0.0f,
-		-.98f, 0.0f, 0.17f,		0.0f, -1.0f, 0.0f,	0.6f, 0.017f,
-		-.94f, 0.0f, 0.34f,		0.0f, -1.0f, 0.0f,	0.68f, 0.04f,
-		-.87f, 0.0f, 0.5f,		0.0f, -1.0f, 0.0f,	0.77f, 0.08f,
-		-.77f, 0.0f, 0.64f,		0.0f, -1.0f, 0.0f,	0.83f, 0.13f,
-		-.64f, 0.0f, 0.77f,		0.0f, -1.0f, 0.0f,	0.87f, 0.17f,
-		-.5f, 0.0f, 0.87f,		0.0f, -1.0f, 0.0f,	0.92f, 0.25f,
-		-.34f, 0.0f, 0.94f,		0.0f, -1.0f, 0.0f,	0.96f, 0.33f,
-		-.17f, 0.0f, 0.98f,		0.0f, -1.0f, 0.0f,	0.983f, 0.41f,
-		0.0f, 0.0f, 1.0f,		0.0f, -1.0f, 0.0f,	1.0f, 0.5f,
-		.17f, 0.0f, 0.98f,		0.0f, -1.0f, 0.0f,	0.983f, 0.6f,
-		.34f, 0.0f, 0.94f,		0.0f, -1.0f, 0.0f,	0.96f, 0.68f,
-		.5f, 0.0f, 0.87f,		0.0f, -1.0f, 0.0f,	0.92f, 0.77f,
-		.64f, 0.0f, 0.77f,		0.0f, -1.0f, 0.0f,	0.87f, 0.83f,
-		.77f, 0.0f, 0.64f,		0.0f, -1.0f, 0.0f,	0.83f, 0.87f,
-		.87f, 0.0f, 0.5f,		0.0f, -1.0f, 0.0f,	0.77f, 0.92f,
-		.94f, 0.0f, 0.34f,		0.0f, -1.0f, 0.0f,	0.68f, 0.96f,
-		.98f, 0.0f, 0.17f,		0.0f, -1.0f, 0.0f,	0.6f, 0.983f,
-
-		// cone sides		// normals									// texture coords
-		1.0f, 0.0f, 0.0f,		0.993150651f, 0.0f, -0.116841137f, 		1.0f,0.5f,
-		0.0f, 1.0f, 0.0f,		0.993150651f, 0.0f, -0.116841137f, 		0.5f, 0.5f,
-		.98f, 0.0f, -0.17f,		0.993150651f, 0.0f, -0.116841137f, 		0.983f,0.6f,
-		.98f, 0.0f, -0.17f,		0.973417103f, 0.0f, -0.229039446f, 		0.983f,0.6f,
-		0.0f, 1.0f, 0.0f,		0.973417103f, 0.0f, -0.229039446f, 		0.5f, 0.5f,
-		.94f, 0.0f, -0.34f,		0.973417103f, 0.0f, -0.229039446f, 		0.96f,0.68f,
-		.94f, 0.0f, -0.34f,		0.916157305f, 0.0f, -0.400818795f, 		0.96f,0.68f,
-		0.0f, 1.0f, 0.0f,		0.916157305f, 0.0f, -0.400818795f, 		0.5f, 0.5f,
-		.87f, 0.0f, -0.5f,		0.916157305f, 0.0f, -0.400818795f, 		0.92f,0.77f,
-		.87f, 0.0f, -0.5f,		0.813733339f, 0.0f, -0.581238329f, 		0.92f,0.77f,
-		0.0f, 1.0f, 0.0f,		0.813733339f, 0.0f, -0.581238329f, 		0.5f, 0.5f,
-		.77f, 0.0f, -0.64f,		0.813733339f, 0.0f, -0.581238329f, 		0.87f, 0.83f,
-		.77f, 0.0f, -0.64f,		0.707106769f, 0.0f, -0.707106769f, 		0.87f, 0.83f,
-		0.0f, 1.0f, 0.0f,		0.707106769f, 0.0f, -0.707106769f, 		0.5f, 0.5f,
-		.64f, 0.0f, -0.77f,		0.707106769f, 0.0f, -0.707106769f, 		0.83f, 0.87f,
-		.64f, 0.0f, -0.77f,		0.581238329f, 0.0f, -0.813733339f, 		0.83f, 0.87f,
-		0.0f, 1.0f, 0.0f,		0.581238329f, 0.0f, -0.813733339f, 		0.5f, 0.5f,
-		.5f, 0.0f, -0.87f,		0.581238329f, 0.0f, -0.813733339f, 		0.77f, 0.92f,
-		.5f, 0.0f, -0.87f,		0.400818795f, 0.0f, -0.916157305f, 		0.77f, 0.92f,
-		0.0f, 1.0f, 0.0f,		0.400818795f, 0.0f, -0.916157305f, 		0.5f, 0.5f,
-		.34f, 0.0f, -0.94f,		0.400818795f, 0.0f, -0.916157305f, 		0.68f, 0.96f,
-		.34f, 0.0f, -0.94f,		0.229039446f, 0.0f, -0.973417103f, 		0.68f, 0.96f,
-		0.0f, 1.0f, 0.0f,		0.229039446f, 0.0f, -0.973417103f, 		0.5f, 0.5f,
-		.17f, 0.0f, -0.98f,		0.229039446f, 0.0f, -0.973417103f, 		0.6f, 0.983f,
-		.17f, 0.0f, -0.98f,		0.116841137f, 0.0f, -0.993150651f, 		0.6f, 0.983f,
-		0.0f, 1.0f, 0.0f,		0.116841137f, 0.0f, -0.993150651f, 		0.5f, 0.5f,
-		0.0f, 0.0f, -1.0f,		0.116841137f, 0.0f, -0.993150651f, 		0.5f, 1.0f,
-
-		0.0f, 0.0f, -1.0f,		-0.116841137f, 0.0f, -0.993150651f, 		0.5f, 1.0f,
-		0.0f, 1.0f, 0.0f,		-0.116841137f, 0.0f, -0.993150651f, 		0.5f, 0.5f,
-		-.17f, 0.0f, -0.98f,	-0.116841137f, 0.0f, -0.993150651f, 		0.41f, 0.983f,
-		-.17f, 0.0f, -0.98f,	-0.229039446f, 0.0f, -0.973417103f, 		0.41f, 0.983f,
-		0.0f, 1.0f, 0.0f,		-0.229039446f, 0.0f, -0.973417103f, 		0.5f, 0.5f,
-		-.34f, 0.0f, -0.94f,	-0.229039446f, 0.0f, -0.973417103f, 		0.33f, 0.96f,
-		-.34f, 0.0f, -0.94f,	-0.400818795f, 0.0f, -0.916157305f, 		0.33f, 0.96f,
-		0.0f, 1.0f, 0.0f,		-0.400818795f, 0.0f, -0.916157305f, 		0.5f, 0.5f,
-		-.5f, 0.0f, -0.87f,		-0.400818795f, 0.0f, -0.916157305f, 		0.25f, 0.92f,
-		-.5f, 0.0f, -0.87f,		-0.581238329f, 0.0f, -0.813733339f, 		0.25f, 0.92f,
-		0.0f, 1.0f, 0.0f,		-0.581238329f, 0.0f, -0.813733339f, 		0.5f, 0.5f,
-		-.64f, 0.0f, -0.77f,	-0.581238329f, 0.0f, -0.813733339f, 		0.17f, 0.87f,
-		-.64f, 0.0f, -0.77f,	-0.707106769f, 0.0f, -0.707106769f, 		0.17f, 0.87f,
-		0.0f, 1.0f, 0.0f,		-0.707106769f, 0.0f, -0.707106769f, 		0.5f, 0.5f,
-		-.77f, 0.0f, -0.64f,	-0.707106769f, 0.0f, -0.707106769f, 		0.13f, 0.83f,
-		-.77f, 0.0f, -0.64f,	-0.813733339f, 0.0f, -0.581238329f, 		0.13f, 0.83f,
-		0.0f, 1.0f, 0.0f,		-0.813733339f, 0.0f, -0.581238329f, 		0.5f, 0.5f,
-		-.87f, 0.0f, -0.5f,		-0.813733339f, 0.0f, -0.581238329f, 		0.08f, 0.77f,
-		-.87f, 0.0f, -0.5f,		-0.916157305f, 0.0f, -0.400818795f, 		0.08f, 0.77f,
-		0.0f, 1.0f, 0.0f,		-0.916157305f, 0.0f, -0.400818795f, 		0.5f, 0.5f,
-		-.94f, 0.0f, -0.34f,	-0.916157305f, 0.0f, -0.400818795f, 		0.04f, 0.68f,
-		-.94f, 0.0f, -0.34f,	-0.973417103f, 0.0f, -0.229039446f, 		0.04f, 0.68f,
-		0.0f, 1.0f, 0.0f,		-0.973417103f, 0.0f, -0.229039446f, 		0.5f, 0.5f,
-		-.98f, 0.0f, -0.17f,	-0.973417103f, 0.0f, -0.229039446f, 		0.017f, 0.6f,
-		-.98f, 0.0f, -0.17f,	-0.993150651f, 0.0f, -0.116841137f, 		0.017f, 0.6f,
-		0.0f, 1.0f, 0.0f,		-0.993150651f, 0.0f, -0.116841137f, 		0.5f, 0.5f,
-		-1.0f, 0.0f, 0.0f,		-0.993150651f, 0.0f, -0.116841137f, 		0.0f, 0.5f,
-		-1.0f, 0.0f, 0.0f,		-0.993150651f, 0.0f, -0.116841137f, 		0.0f, 0.5f,
-		0.0f, 1.0f, 0.0f,		-0.993150651f, 0.0f, 0.116841137f, 		0.5f, 0.5f,
-		-.98f, 0.0f, 0.17f,		-0.993150651f, 0.0f, 0.116841137f, 		0.017f, 0.41f,
-		-.98f, 0.0f, 0.17f,		-0.973417103f, 0.0f, 0.229039446f, 		0.017f, 0.41f,
-		0.0f, 1.0f, 0.0f,		-0.973417103f, 0.0f, 0.229039446f, 		0.5f, 0.5f,
-		-.94f, 0.0f, 0.34f,		-0.973417103f, 0.0f, 0.229039446f, 		0.04f, 0.33f,
-		-.94f, 0.0f, 0.34f,		-0.916157305f, 0.0f, 0.400818795f, 		0.04f, 0.33f,
-		0.0f, 1.0f, 0.0f,		-0.916157305f, 0.0f, 0.400818795f, 		0.5f, 0.5f,
-		-.87f, 0.0f, 0.5f,		-0.916157305f, 0.0f, 0.400818795f, 		0.08f, 0.25f,
-		-.87f, 0.0f, 0.5f,		-0.813733339f, 0.0f, 0.581238329f, 		0.08f, 0.25f,
-		0.0f, 1.0f, 0.0f,		-0.813733339f, 0.0f, 0.581238329f, 		0.5f, 0.5f,
-		-.77f, 0.0f, 0.64f,		-0.813733339f, 0.0f, 0.581238329f, 		0.13f, 0.17f,
-		-.77f, 0.0f, 0.64f,		-0.707106769f, 0.0f, 0.707106769f, 		0.13f, 0.17f,
-		0.0f, 1.0f, 0.0f,		-0.707106769f, 0.0f, 0.707106769f, 		0.5f, 0.5f,
-		-.64f, 0.0f, 0.77f,		-0.707106769f, 0.0f, 0.707106769f, 		0.17f, 0.13f,
-		-.64f, 0.0f, 0.77f,		-0.581238329f, 0.0f, 0.813733339f, 		0.17f, 0.13f,
-		0.0f, 1.0f, 0.0f,		-0.581238329f, 0.0f, 0.813733339f, 		0.5f, 0.5f,
-		-.5f, 0.0f, 0.87f,		-0.581238329f, 0.0f, 0.813733339f, 		0.25f, 0.08f,
-		-.5f, 0.0f, 0.87f,		-0.400818795f, 0.0f, 0.916157305f, 		0.25f, 0.08f,
-		0.0f, 1.0f, 0.0f,		-0.400818795f, 0.0f, 0.916157305f, 		0.5f, 0.5f,
-		-.34f, 0.0f, 0.94f,		-0.400818795f, 0.0f, 0.916157305f, 		0.33f, 0.04f,
-		-.34f, 0.0f, 0.94f,		-0.229039446f, 0.0f, 0.973417103f, 		0.33f, 0.04f,
-		0.0f, 1.0f, 0.0f,		-0.229039446f, 0.0f, 0.973417103f, 		0.5f, 0.5f,
-		-.17f, 0.0f, 0.98f,		-0.229039446f, 0.0f, 0.973417103f, 		0.41f, 0.017f,
-		-.17f, 0.0f, 0.98f,		-0.116841137f, 0.0f, 0.993150651f, 		0.41f, 0.017f,
-		0.0f, 1.0f, 0.0f,		-0.116841137f, 0.0f, 0.993150651f, 		0.5f, 0.5f,
-		0.0f, 0.0f, 1.0f,		-0.116841137f, 0.0f, 0.993150651f, 		0.5f, 0.0f,
-		0.0f, 0.0f, 1.0f,		0.116841137f, 0.0f, 0.993150651f, 	0.5f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.116841137f, 0.0f, 0.993150651f, 	0.5f, 0.5f,
-		.17f, 0.0f, 0.98f,		0.116841137f, 0.0f, 0.993150651f, 	0.6f, 0.017f,
-		.17f, 0.0f, 0.98f,		0.229039446f, 0.0f, 0.973417103f, 	0.6f, 0.017f,
-		0.0f, 1.0f, 0.0f,		0.229039446f, 0.0f, 0.973417103f, 	0.5f, 0.5f,
-		.34f, 0.0f, 0.94f,		0.229039446f, 0.0f, 0.973417103f, 	0.68f, 0.04f,
-		.34f, 0.0f, 0.94f,		0.400818795f, 0.0f, 0.916157305f, 	0.68f, 0.04f,
-		0.0f, 1.0f, 0.0f,		0.400818795f, 0.0f, 0.916157305f, 	0.5f, 0.5f,
-		.5f, 0.0f, 0.87f,		0.400818795f, 0.0f, 0.916157305f, 	0.77f, 0.08f,
-		.5f, 0.0f, 0.87f,		0.581238329f, 0.0f, 0.813733339f, 	0.77f, 0.08f,
-		0.0f, 1.0f, 0.0f,		0.581238329f, 0.0f, 0.813733339f, 	0.5f, 0.5f,
-		.64f, 0.0f, 0.77f,		0.581238329f, 0.0f, 0.813733339f, 	0.83f, 0.13f,
-		.64f, 0.0f, 0.77f,		0.707106769f, 0.0f, 0.707106769f, 	0.83f, 0.13f,
-		0.0f, 1.0f, 0.0f,		0.707106769f, 0.0f, 0.707106769f, 	0.5f, 0.5f,
-		.77f, 0.0f, 0.64f,		0.707106769f, 0.0f, 0.707106769f, 	0.87f, 0.17f,
-		.77f, 0.0f, 0.64f,		0.813733339f, 0.0f, 0.581238329f, 	0.87f, 0.17f,
-		0.0f, 1.0f, 0.0f,		0.813733339f, 0.0f, 0.581238329f, 	0.5f, 0.5f,
-		.87f, 0.0f, 0.5f,		0.813733339f, 0.0f, 0.581238329f, 	0.92f, 0.25f,
-		.87f, 0.0f, 0.5f,		0.916157305f, 0.0f, 0.400818795f, 	0.92f, 0.25f,
-		0.0f, 1.0f, 0.0f,		0.916157305f, 0.0f, 0.400818795f, 	0.5f, 0.5f,
-		.94f, 0.0f, 0.34f,		0.916157305f, 0.0f, 0.400818795f, 	0.96f, 0.33f,
-		.94f, 0.0f, 0.34f,		0.973417103f, 0.0f, 0.229039446f, 	0.96f, 0.33f,
-		0.0f, 1.0f, 0.0f,		0.973417103f, 0.0f, 0.229039446f, 	0.5f, 0.5f,
-		.98f, 0.0f, 0.17f,		0.973417103f, 0.0f, 0.229039446f, 	0.983f, 0.41f,
-		.98f, 0.0f, 0.17f,		0.993150651f, 0.0f, 0.116841137f, 	0.983f, 0.41f,
-		0.0f, 1.0f, 0.0f,		0.993150651f, 0.0f, 0.116841137f, 	0.5f, 0.5f,
-		1.0f, 0.0f, 0.0f,		0.993150651f, 0.0f, 0.116841137f, 	1.0f, 0.5f
-	};
-
-	// store vertex and index count
-	m_ConeMesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (g_FloatsPerVertex + g_FloatsPerNormal + g_FloatsPerUV));
-	m_ConeMesh.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &m_ConeMesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(m_ConeMesh.vao);
-
-	// Create VBO
-	glGenBuffers(1, m_ConeMesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, m_ConeMesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	if (m_bMemoryLayoutDone == false)
+	MESH_DATA& data = BeginMeshScratch();
+	if (m_pendingConeData.valid())
 	{
-		SetShaderMemoryLayout();
+		data = m_pendingConeData.get();
+	}
+	else
+	{
+		GenerateConicMeshData(data, 1.0f, 0.0f, false);
 	}
+	UploadMeshData(m_ConeMesh, data);
 }
 
 ///////////////////////////////////////////////////
 //	LoadCylinderMesh()
 //
-//	Create a cylinder mesh by specifying the vertices and 
-//  store it in a VAO/VBO.  The normals and texture
-//  coordinates are also set.
+//	Create an indexed cylinder mesh and store it in a
+//  VAO/VBO.  The normals and texture coordinates
+//  are also set.
 //
 //  Correct triangle drawing commands:
 //
-//	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-//	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-//	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
+//	glDrawElements(GL_TRIANGLES, meshes.gCylinderMesh.nBottomIndices, GL_UNSIGNED_INT, (void*)0);	//bottom
+//	glDrawElements(GL_TRIANGLES, meshes.gCylinderMesh.nTopIndices, GL_UNSIGNED_INT, (void*)(meshes.gCylinderMesh.nBottomIndices * sizeof(GLuint)));	//top
+//	glDrawElements(GL_TRIANGLES, meshes.gCylinderMesh.nSideIndices, GL_UNSIGNED_INT, (void*)((meshes.gCylinderMesh.nBottomIndices + meshes.gCylinderMesh.nTopIndices) * sizeof(GLuint)));	//sides
 ///////////////////////////////////////////////////
 void ShapeMeshes::LoadCylinderMesh()
 {
-	GLfloat verts[] = {
-		// cylinder bottom		// normals			// texture coords
-		1.0f, 0.0f, 0.0f,		0.0f, -1.0f, 0.0f,	0.5f,1.0f,
-		.98f, 0.0f, -0.17f,		0.0f, -1.0f, 0.0f,	0.41f, 0.983f,
-		.94f, 0.0f, -0.34f,		0.0f, -1.0f, 0.0f,	0.33f, 0.96f,
-		.87f, 0.0f, -0.5f,		0.0f, -1.0f, 0.0f,	0.25f, 0.92f,
-		.77f, 0.0f, -0.64f,		0.0f, -1.0f, 0.0f,	0.17f, 0.87f,
-		.64f, 0.0f, -0.77f,		0.0f, -1.0f, 0.0f,	0.13f, 0.83f,
-		.5f, 0.0f, -0.87f,		0.0f, -1.0f, 0.0f,	0.08f, 0.77f,
-		.34f, 0.0f, -0.94f,		0.0f, -1.0f, 0.0f,	0.04f, 0.68f,
-		.17f, 0.0f, -0.98f,		0.0f, -1.0f, 0.0f,	0.017f, 0.6f,
-		0.0f, 0.0f, -1.0f,		0.0f, -1.0f, 0.0f,	0.0f,0.5f,
-		-.17f, 0.0f, -0.98f,	0.0f, -1.0f, 0.0f,	0.017f, 0.41f,
-		-.34f, 0.0f, -0.94f,	0.0f, -1.0f, 0.0f,	0.04f, 0.33f,
-		-.5f, 0.0f, -0.87f,		0.0f, -1.0f, 0.0f,	0.08f, 0.25f,
-		-.64f, 0.0f, -0.77f,	0.0f, -1.0f, 0.0f,	0.13f, 0.17f,
-		-.77f, 0.0f, -0.64f,	0.0f, -1.0f, 0.0f,	0.17f, 0.13f,
-		-.87f, 0.0f, -0.5f,		0.0f, -1.0f, 0.0f,	0.25f, 0.08f,
-		-.94f, 0.0f, -0.34f,	0.0f, -1.0f, 0.0f,	0.33f, 0.04f,
-		-.98f, 0.0f, -0.17f,	0.0f, -1.0f, 0.0f,	0.41f, 0.017f,
-		-1.0f, 0.0f, 0.0f,		0.0f, -1.0f, 0.0f,	0.5f, 0.0f,
-		-.98f, 0.0f, 0.17f,		0.0f, -1.0f, 0.0f,	0.6f, 0.017f,
-		-.94f, 0.0f, 0.34f,		0.0f, -1.0f, 0.0f,	0.68f, 0.04f,
-		-.87f, 0.0f, 0.5f,		0.0f, -1.0f, 0.0f,	0.77f, 0.08f,
-		-.77f, 0.0f, 0.64f,		0.0f, -1.0f, 0.0f,	0.83f, 0.13f,
-		-.64f, 0.0f, 0.77f,		0.0f, -1.0f, 0.0f,	0.87f, 0.17f,
-		-.5f, 0.0f, 0.87f,		0.0f, -1.0f, 0.0f,	0.92f, 0.25f,
-		-.34f, 0.0f, 0.94f,		0.0f, -1.0f, 0.0f,	0.96f, 0.33f,
-		-.17f, 0.0f, 0.98f,		0.0f, -1.0f, 0.0f,	0.983f, 0.41f,
-		0.0f, 0.0f, 1.0f,		0.0f, -1.0f, 0.0f,	1.0f, 0.5f,
-		.17f, 0.0f, 0.98f,		0.0f, -1.0f, 0.0f,	0.983f, 0.6f,
-		.34f, 0.0f, 0.94f,		0.0f, -1.0f, 0.0f,	0.96f, 0.68f,
-		.5f, 0.0f, 0.87f,		0.0f, -1.0f, 0.0f,	0.92f, 0.77f,
-		.64f, 0.0f, 0.77f,		0.0f, -1.0f, 0.0f,	0.87f, 0.83f,
-		.77f, 0.0f, 0.64f,		0.0f, -1.0f, 0.0f,	0.83f, 0.87f,
-		.87f, 0.0f, 0.5f,		0.0f, -1.0f, 0.0f,	0.77f, 0.92f,
-		.94f, 0.0f, 0.34f,		0.0f, -1.0f, 0.0f,	0.68f, 0.96f,
-		.98f, 0.0f, 0.17f,		0.0f, -1.0f, 0.0f,	0.6f, 0.983f,
-
-		// cylinder top			// normals			// texture coords
-		1.0f, 1.0f, 0.0f,		0.0f, 1.0f, 0.0f,	0.5f,1.0f,
-		.98f, 1.0f, -0.17f,		0.0f, 1.0f, 0.0f,	0.41f, 0.983f,
-		.94f, 1.0f, -0.34f,		0.0f, 1.0f, 0.0f,	0.33f, 0.96f,
-		.87f, 1.0f, -0.5f,		0.0f, 1.0f, 0.0f,	0.25f, 0.92f,
-		.77f, 1.0f, -0.64f,		0.0f, 1.0f, 0.0f,	0.17f, 0.87f,
-		.64f, 1.0f, -0.77f,		0.0f, 1.0f, 0.0f,	0.13f, 0.83f,
-		.5f, 1.0f, -0.87f,		0.0f, 1.0f, 0.0f,	0.08f, 0.77f,
-		.34f, 1.0f, -0.94f,		0.0f, 1.0f, 0.0f,	0.04f, 0.68f,
-		.17f, 1.0f, -0.98f,		0.0f, 1.0f, 0.0f,	0.017f, 0.6f,
-		0.0f, 1.0f, -1.0f,		0.0f, 1.0f, 0.0f,	0.0f,0.5f,
-		-.17f, 1.0f, -0.98f,	0.0f, 1.0f, 0.0f,	0.017f, 0.41f,
-		-.34f, 1.0f, -0.94f,	0.0f, 1.0f, 0.0f,	0.04f, 0.33f,
-		-.5f, 1.0f, -0.87f,		0.0f, 1.0f, 0.0f,	0.08f, 0.25f,
-		-.64f, 1.0f, -0.77f,	0.0f, 1.0f, 0.0f,	0.13f, 0.17f,
-		-.77f, 1.0f, -0.64f,	0.0f, 1.0f, 0.0f,	0.17f, 0.13f,
-		-.87f, 1.0f, -0.5f,		0.0f, 1.0f, 0.0f,	0.25f, 0.08f,
-		-.94f, 1.0f, -0.34f,	0.0f, 1.0f, 0.0f,	0.33f, 0.04f,
-		-.98f, 1.0f, -0.17f,	0.0f, 1.0f, 0.0f,	0.41f, 0.017f,
-		-1.0f, 1.0f, 0.0f,		0.0f, 1.0f, 0.0f,	0.5f, 0.0f,
-		-.98f, 1.0f, 0.17f,		0.0f, 1.0f, 0.0f,	0.6f, 0.017f,
-		-.94f, 1.0f, 0.34f,		0.0f, 1.0f, 0.0f,	0.68f, 0.04f,
-		-.87f, 1.0f, 0.5f,		0.0f, 1.0f, 0.0f,	0.77f, 0.08f,
-		-.77f, 1.0f, 0.64f,		0.0f, 1.0f, 0.0f,	0.83f, 0.13f,
-		-.64f, 1.0f, 0.77f,		0.0f, 1.0f, 0.0f,	0.87f, 0.17f,
-		-.5f, 1.0f, 0.87f,		0.0f, 1.0f, 0.0f,	0.92f, 0.25f,
-		-.34f, 1.0f, 0.94f,		0.0f, 1.0f, 0.0f,	0.96f, 0.33f,
-		-.17f, 1.0f, 0.98f,		0.0f, 1.0f, 0.0f,	0.983f, 0.41f,
-		0.0f, 1.0f, 1.0f,		0.0f, 1.0f, 0.0f,	1.0f, 0.5f,
-		.17f, 1.0f, 0.98f,		0.0f, 1.0f, 0.0f,	0.983f, 0.6f,
-		.34f, 1.0f, 0.94f,		0.0f, 1.0f, 0.0f,	0.96f, 0.68f,
-		.5f, 1.0f, 0.87f,		0.0f, 1.0f, 0.0f,	0.92f, 0.77f,
-		.64f, 1.0f, 0.77f,		0.0f, 1.0f, 0.0f,	0.87f, 0.83f,
-		.77f, 1.0f, 0.64f,		0.0f, 1.0f, 0.0f,	0.83f, 0.87f,
-		.87f, 1.0f, 0.5f,		0.0f, 1.0f, 0.0f,	0.77f, 0.92f,
-		.94f, 1.0f, 0.34f,		0.0f, 1.0f, 0.0f,	0.68f, 0.96f,
-		.98f, 1.0f, 0.17f,		0.0f, 1.0f, 0.0f,	0.6f, 0.983f,
-
-		// cylinder body		// normals							// texture coords
-		1.0f, 1.0f, 0.0f,		0.993150651f, 0.5f, -0.116841137f,	0.0,1.0,
-		1.0f, 0.0f, 0.0f,		0.993150651f, 0.5f, -0.116841137f,	0.0,0.0,
-		.98f, 0.0f, -0.17f,		0.993150651f, 0.5f, -0.116841137f,	0.0277,0.0,
-		1.0f, 1.0f, 0.0f,		0.993150651f, 0.5f, -0.116841137f,	0.0,1.0,
-		.98f, 1.0f, -0.17f,		0.973417103f, 0.5f, -0.229039446f,	0.0277,1.0,
-		.98f, 0.0f, -0.17f,		0.973417103f, 0.5f, -0.229039446f,	0.0277,0.0,
-		.94f, 0.0f, -0.34f,		0.973417103f, 0.0f, -0.229039446f,	0.0554,0.0,
-		.98f, 1.0f, -0.17f,		0.973417103f, 0.0f, -0.229039446f,	0.0277,1.0,
-		.94f, 1.0f, -0.34f,		0.916157305f, 0.0f, -0.400818795f,	0.0554,1.0,
-		.94f, 0.0f, -0.34f,		0.916157305f, 0.0f, -0.400818795f,	0.0554,0.0,
-		.87f, 0.0f, -0.5f,		0.916157305f, 0.0f, -0.400818795f,	0.0831,0.0,
-		.94f, 1.0f, -0.34f,		0.916157305f, 0.0f, -0.400818795f,	0.0554,1.0,
-		.87f, 1.0f, -0.5f,		0.813733339f, 0.0f, -0.581238329f,	0.0831,1.0,
-		.87f, 0.0f, -0.5f,		0.813733339f, 0.0f, -0.581238329f,	0.0831,0.0,
-		.77f, 0.0f, -0.64f,		0.813733339f, 0.0f, -0.581238329f,	0.1108,0.0,
-		.87f, 1.0f, -0.5f,		0.813733339f, 0.0f, -0.581238329f,	0.0831,1.0,
-		.77f, 1.0f, -0.64f,		0.707106769f, 0.0f, -0.707106769f,	0.1108,1.0,
-		.77f, 0.0f, -0.64f,		0.707106769f, 0.0f, -0.707106769f,	0.1108,0.0,
-		.64f, 0.0f, -0.77f,		0.707106769f, 0.0f, -0.707106769f,	0.1385,0.0,
-		.77f, 1.0f, -0.64f,		0.707106769f, 0.0f, -0.707106769f,	0.1108,1.0,
-		.64f, 1.0f, -0.77f,		0.581238329f, 0.0f, -0.813733339f,	0.1385,1.0,
-		.64f, 0.0f, -0.77f,		0.581238329f, 0.0f, -0.813733339f,	0.1385,0.0,
-		.5f, 0.0f, -0.87f,		0.581238329f, 0.0f, -0.813733339f,	0.1662,0.0,
-		.64f, 1.0f, -0.77f,		0.581238329f, 0.0f, -0.813733339f,	0.1385, 1.0,
-		.5f, 1.0f, -0.87f,		0.400818795f, 0.0f, -0.916157305f,	0.1662, 1.0,
-		.5f, 0.0f, -0.87f,		0.400818795f, 0.0f, -0.916157305f,	0.1662, 0.0,
-		.34f, 0.0f, -0.94f,		0.400818795f, 0.0f, -0.916157305f,	0.1939, 0.0,
-		.5f, 1.0f, -0.87f,		0.400818795f, 0.0f, -0.916157305f,	0.1662, 1.0,
-		.34f, 1.0f, -0.94f,		0.229039446f, 0.0f, -0.973417103f,	0.1939, 1.0,
-		.34f, 0.0f, -0.94f,		0.229039446f, 0.0f, -0.973417103f,	0.1939, 0.0,
-		.17f, 0.0f, -0.98f,		0.229039446f, 0.0f, -0.973417103f,	0.2216, 0.0,
-		.34f, 1.0f, -0.94f,		0.229039446f, 0.0f, -0.973417103f,	0.1939, 1.0,
-		.17f, 1.0f, -0.98f,		0.116841137f, 0.0f, -0.993150651f,	0.2216, 1.0,
-		.17f, 0.0f, -0.98f,		0.116841137f, 0.0f, -0.993150651f,	0.2216, 0.0,
-		0.0f, 0.0f, -1.0f,		0.116841137f, 0.0f, -0.993150651f,	0.2493, 0.0,
-		.17f, 1.0f, -0.98f,		0.116841137f, 0.0f, -0.993150651f,	0.2216, 1.0,
-		0.0f, 1.0f, -1.0f,		0.116841137f, 0.0f, -0.993150651f,	0.2493, 1.0,
-		0.0f, 0.0f, -1.0f,		0.116841137f, 0.0f, -0.993150651f,	0.2493, 0.0,
-		-.17f, 0.0f, -0.98f,	-0.116841137f, 0.0f, -0.993150651f,	0.277, 0.0,
-		0.0f, 1.0f, -1.0f,		-0.116841137f, 0.0f, -0.993150651f,	0.2493, 1.0,
-		-.17f, 1.0f, -0.98f,	-0.229039446f, 0.0f, -0.973417103f,	0.277, 1.0,
-		-.17f, 0.0f, -0.98f,	-0.229039446f, 0.0f, -0.973417103f,	0.277, 0.0,
-		-.34f, 0.0f, -0.94f,	-0.229039446f, 0.0f, -0.973417103f,	0.3047, 0.0,
-		-.17f, 1.0f, -0.98f,	-0.229039446f, 0.0f, -0.973417103f,	0.277, 1.0,
-		-.34f, 1.0f, -0.94f,	-0.400818795f, 0.0f, -0.916157305f,	0.3047, 1.0,
-		-.34f, 0.0f, -0.94f,	-0.400818795f, 0.0f, -0.916157305f,	0.3047, 0.0,
-		-.5f, 0.0f, -0.87f,		-0.400818795f, 0.0f, -0.916157305f,	0.3324, 0.0,
-		-.34f, 1.0f, -0.94f,	-0.400818795f, 0.0f, -0.916157305f,	0.3047, 1.0,
-		-.5f, 1.0f, -0.87f,		-0.581238329f, 0.0f, -0.813733339f,	0.3324, 1.0,
-		-.5f, 0.0f, -0.87f,		-0.581238329f, 0.0f, -0.813733339f,	0.3324, 0.0,
-		-.64f, 0.0f, -0.77f,	-0.581238329f, 0.0f, -0.813733339f,	0.3601, 0.0,
-		-.5f, 1.0f, -0.87f,		-0.581238329f, 0.0f, -0.813733339f,	0.3324, 1.0,
-		-.64f, 1.0f, -0.77f,	-0.707106769f, 0.0f, -0.707106769f,	0.3601, 1.0,
-		-.64f, 0.0f, -0.77f,	-0.707106769f, 0.0f, -0.707106769f,	0.3601, 0.0,
-		-.77f, 0.0f, -0.64f,	-0.707106769f, 0.0f, -0.707106769f,	0.3878, 0.0,
-		-.64f, 1.0f, -0.77f,	-0.707106769f, 0.0f, -0.707106769f,	0.3601, 1.0,
-		-.77f, 1.0f, -0.64f,	-0.813733339f, 0.0f, -0.581238329f,	0.3878, 1.0,
-		-.77f, 0.0f, -0.64f,	-0.813733339f, 0.0f, -0.581238329f,	0.3878, 0.0,
-		-.87f, 0.0f, -0.5f,		-0.813733339f, 0.0f, -0.581238329f,	0.4155, 0.0,
-		-.77f, 1.0f, -0.64f,	-0.813733339f, 0.0f, -0.581238329f,	0.3878, 1.0,
-		-.87f, 1.0f, -0.5f,		-0.916157305f, 0.0f, -0.400818795f,	0.4155, 1.0,
-		-.87f, 0.0f, -0.5f,		-0.916157305f, 0.0f, -0.400818795f,	0.4155, 0.0,
-		-.94f, 0.0f, -0.34f,	-0.916157305f, 0.0f, -0.400818795f,	0.4432, 0.0,
-		-.87f, 1.0f, -0.5f,		-0.916157305f, 0.0f, -0.400818795f,	0.4155, 1.0,
-		-.94f, 1.0f, -0.34f,	-0.973417103f, 0.0f, -0.229039446f,	0.4432, 1.0,
-		-.94f, 0.0f, -0.34f,	-0.973417103f, 0.0f, -0.229039446f,	0.4432, 0.0,
-		-.98f, 0.0f, -0.17f,	-0.973417103f, 0.0f, -0.229039446f,	0.4709, 0.0,
-		-.94f, 1.0f, -0.34f,	-0.973417103f, 0.0f, -0.229039446f,	0.4432, 1.0,
-		-.98f, 1.0f, -0.17f,	-0.993150651f, 0.0f, -0.116841137f,	0.4709, 1.0,
-		-.98f, 0.0f, -0.17f,	-0.993150651f, 0.0f, -0.116841137f,	0.4709, 0.0,
-		-1.0f, 0.0f, 0.0f,		-0.993150651f, 0.0f, -0.116841137f,	0.4986, 0.0,
-		-.98f, 1.0f, -0.17f,	-0.993150651f, 0.0f, -0.116841137f,	0.4709, 1.0,
-		-1.0f, 1.0f, 0.0f,		-0.993150651f, 0.0f, -0.116841137f,	0.4986, 1.0,
-		-1.0f, 0.0f, 0.0f,		-0.993150651f, 0.0f, -0.116841137f,	0.4986, 0.0,
-		-.98f, 0.0f, 0.17f,		-0.993150651f, 0.0f, 0.116841137f,	0.5263, 0.0,
-		-1.0f, 1.0f, 0.0f,		-0.993150651f, 0.0f, 0.116841137f,	0.4986, 1.0,
-		-.98f, 1.0f, 0.17f,		-0.973417103f, 0.0f, 0.229039446f,	0.5263, 1.0,
-		-.98f, 0.0f, 0.17f,		-0.973417103f, 0.0f, 0.229039446f,	0.5263, 0.0,
-		-.94f, 0.0f, 0.34f,		-0.973417103f, 0.0f, 0.229039446f,	0.554, 0.0,
-		-.98f, 1.0f, 0.17f,		-0.973417103f, 0.0f, 0.229039446f,	0.5263, 1.0,
-		-.94f, 1.0f, 0.34f,		-0.916157305f, 0.0f, 0.400818795f,	0.554, 1.0,
-		-.94f, 0.0f, 0.34f,		-0.916157305f, 0.0f, 0.400818795f,	0.554, 0.0,
-		-.87f, 0.0f, 0.5f,		-0.916157305f, 0.0f, 0.400818795f,	0.5817, 0.0,
-		-.94f, 1.0f, 0.34f,		-0.916157305f, 0.0f, 0.400818795f,	0.554, 1.0,
-		-.87f, 1.0f, 0.5f,		-0.813733339f, 0.0f, 0.581238329f,	0.5817, 1.0,
-		-.87f, 0.0f, 0.5f,		-0.813733339f, 0.0f, 0.581238329f,	0.5817, 0.0,
-		-.77f, 0.0f, 0.64f,		-0.813733339f, 0.0f, 0.581238329f,	0.6094, 0.0,
-		-.87f, 1.0f, 0.5f,		-0.813733339f, 0.0f, 0.581238329f,	0.5817, 1.0,
-		-.77f, 1.0f, 0.64f,		-0.707106769f, 0.0f, 0.707106769f,	0.6094, 1.0,
-		-.77f, 0.0f, 0.64f,		-0.707106769f, 0.0f, 0.707106769f,	0.6094, 0.0,
-		-.64f, 0.0f, 0.77f,		-0.707106769f, 0.0f, 0.707106769f,	0.6371, 0.0,
-		-.77f, 1.0f, 0.64f,		-0.707106769f, 0.0f, 0.707106769f,	0.6094, 1.0,
-		-.64f, 1.0f, 0.77f,		-0.581238329f, 0.0f, 0.813733339f,	0.6371, 1.0,
-		-.64f, 0.0f, 0.77f,		-0.581238329f, 0.0f, 0.813733339f,	0.6371, 0.0,
-		-.5f, 0.0f, 0.87f,		-0.581238329f, 0.0f, 0.813733339f,	0.6648, 0.0,
-		-.64f, 1.0f, 0.77f,		-0.581238329f, 0.0f, 0.813733339f,	0.6371, 1.0,
-		-.5f, 1.0f, 0.87f,		-0.400818795f, 0.0f, 0.916157305f,	0.6648, 1.0,
-		-.5f, 0.0f, 0.87f,		-0.400818795f, 0.0f, 0.916157305f,	0.6648, 0.0,
-		-.34f, 0.0f, 0.94f,		-0.400818795f, 0.0f, 0.916157305f,	0.6925, 0.0,
-		-.5f, 1.0f, 0.87f,		-0.400818795f, 0.0f, 0.916157305f,	0.6648, 1.0,
-		-.34f, 1.0f, 0.94f,		-0.229039446f, 0.0f, 0.973417103f,	0.6925, 1.0,
-		-.34f, 0.0f, 0.94f,		-0.229039446f, 0.0f, 0.973417103f,	0.6925, 0.0,
-		-.17f, 0.0f, 0.98f,		-0.229039446f, 0.0f, 0.973417103f,	0.7202, 0.0,
-		-.34f, 1.0f, 0.94f,		-0.229039446f, 0.0f, 0.973417103f,	0.6925, 1.0,
-		-.17f, 1.0f, 0.98f,		-0.116841137f, 0.0f, 0.993150651f,	0.7202, 1.0,
-		-.17f, 0.0f, 0.98f,		-0.116841137f, 0.0f, 0.993150651f,	0.7202, 0.0,
-		0.0f, 0.0f, 1.0f,		0.116841137f, 0.0f, 0.993150651f,	0.7479, 0.0,
-		-.17f, 1.0f, 0.98f,		-0.116841137f, 0.0f, 0.993150651f,	0.7202, 1.0,
-		0.0f, 1.0f, 1.0f,		0.116841137f, 0.0f, 0.993150651f,	0.7479, 1.0,
-		0.0f, 0.0f, 1.0f,		0.116841137f, 0.0f, 0.993150651f,	0.7479, 0.0,
-		.17f, 0.0f, 0.98f,		0.116841137f, 0.0f, 0.993150651f,	0.7756, 0.0,
-		0.0f, 1.0f, 1.0f,		0.116841137f, 0.0f, 0.993150651f,	0.7479, 1.0,
-		.17f, 1.0f, 0.98f,		0.229039446f, 0.0f, 0.973417103f,	0.7756, 1.0,
-		.17f, 0.0f, 0.98f,		0.229039446f, 0.0f, 0.973417103f,	0.7756, 0.0,
-		.34f, 0.0f, 0.94f,		0.229039446f, 0.0f, 0.973417103f,	0.8033, 0.0,
-		.17f, 1.0f, 0.98f,		0.229039446f, 0.0f, 0.973417103f,	0.7756, 1.0,
-		.34f, 1.0f, 0.94f,		0.400818795f, 0.0f, 0.916157305f,	0.8033, 1.0,
-		.34f, 0.0f, 0.94f,		0.400818795f, 0.0f, 0.916157305f,	0.8033, 0.0,
-		.5f, 0.0f, 0.87f,		0.400818795f, 0.0f, 0.916157305f,	0.831, 0.0,
-		.34f, 1.0f, 0.94f,		0.400818795f, 0.0f, 0.916157305f,	0.8033, 1.0,
-		.5f, 1.0f, 0.87f,		0.581238329f, 0.0f, 0.813733339f,	0.831, 1.0,
-		.5f, 0.0f, 0.87f,		0.581238329f, 0.0f, 0.813733339f,	0.831, 0.0,
-		.64f, 0.0f, 0.77f,		0.581238329f, 0.0f, 0.813733339f,	0.8587, 0.0,
-		.5f, 1.0f, 0.87f,		0.581238329f, 0.0f, 0.813733339f,	0.831, 1.0,
-		.64f, 1.0f, 0.77f,		0.707106769f, 0.0f, 0.707106769f,	0.8587, 1.0,
-		.64f, 0.0f, 0.77f,		0.707106769f, 0.0f, 0.707106769f,	0.8587, 0.0,
-		.77f, 0.0f, 0.64f,		0.707106769f, 0.0f, 0.707106769f,	0.8864, 0.0,
-		.64f, 1.0f, 0.77f,		0.707106769f, 0.0f, 0.707106769f,	0.8587, 1.0,
-		.77f, 1.0f, 0.64f,		0.813733339f, 0.0f, 0.581238329f,	0.8864, 1.0,
-		.77f, 0.0f, 0.64f,		0.813733339f, 0.0f, 0.581238329f,	0.8864, 0.0,
-		.87f, 0.0f, 0.5f,		0.813733339f, 0.0f, 0.581238329f,	0.9141, 0.0,
-		.77f, 1.0f, 0.64f,		0.813733339f, 0.0f, 0.581238329f,	0.8864, 1.0,
-		.87f, 1.0f, 0.5f,		0.916157305f, 0.0f, 0.400818795f,	0.9141, 1.0,
-		.87f, 0.0f, 0.5f,		0.916157305f, 0.0f, 0.400818795f,	0.9141, 0.0,
-		.94f, 0.0f, 0.34f,		0.916157305f, 0.0f, 0.400818795f,	0.9418, 0.0,
-		.87f, 1.0f, 0.5f,		0.916157305f, 0.0f, 0.400818795f,	0.9141, 1.0,
-		.94f, 1.0f, 0.34f,		0.973417103f, 0.0f, 0.229039446f,	0.9418, 1.0,
-		.94f, 0.0f, 0.34f,		0.973417103f, 0.0f, 0.229039446f,	0.9418, 0.0,
-		.98f, 0.0f, 0.17f,		0.973417103f, 0.0f, 0.229039446f,	0.9695, 0.0,
-		.94f, 1.0f, 0.34f,		0.973417103f, 0.0f, 0.229039446f,	0.9418, 1.0,
-		.98f, 1.0f, 0.17f,		0.993150651f, 0.0f, 0.116841137f,	0.9695, 1.0,
-		.98f, 0.0f, 0.17f,		0.993150651f, 0.0f, 0.116841137f,	0.9695, 0.0,
-		1.0f, 0.0f, 0.0f,		0.993150651f, 0.0f, 0.116841137f,	1.0, 0.0,
-		.98f, 1.0f, 0.17f,		0.993150651f, 0.0f, 0.116841137f,	0.9695, 1.0,
-		1.0f, 1.0f, 0.0f,		0.993150651f, 0.0f, 0.116841137f,	1.0, 1.0,
-		1.0f, 0.0f, 0.0f,		0.993150651f, 0.0f, 0.116841137f,	1.0, 0.0
-	};
-
-	// store vertex and index count
-	m_CylinderMesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (g_FloatsPerVertex + g_FloatsPerNormal + g_FloatsPerUV));
-	m_CylinderMesh.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &m_CylinderMesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(m_CylinderMesh.vao);
-
-	// Create VBO
-	glGenBuffers(1, m_CylinderMesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, m_CylinderMesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	if (m_bMemoryLayoutDone == false)
+	MESH_DATA& data = BeginMeshScratch();
+	if (m_pendingCylinderData.valid())
 	{
-		SetShaderMemoryLayout();
+		data = m_pendingCylinderData.get();
 	}
+	else
+	{
+		GenerateConicMeshData(data, 1.0f, 1.0f, true);
+	}
+	UploadMeshData(m_CylinderMesh, data);
 }
 
 ///////////////////////////////////////////////////
@@ -611,7 +313,7 @@ void ShapeMeshes::LoadPlaneMesh()
 	// Create VBOs for the mesh
 	glGenBuffers(2, m_PlaneMesh.vbos);
 	glBindBuffer(GL_ARRAY_BUFFER, m_PlaneMesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends data to the GPU
+	UploadVertexData(verts, m_PlaneMesh.nVertices); // Sends vertex or coordinate data to the GPU
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_PlaneMesh.vbos[1]); // Activates the buffer
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
@@ -692,7 +394,7 @@ void ShapeMeshes::LoadPrismMesh()
 	// Create 2 buffers: first one for the vertex data; second one for the indices
 	glGenBuffers(1, m_PrismMesh.vbos);
 	glBindBuffer(GL_ARRAY_BUFFER, m_PrismMesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
+	UploadVertexData(verts, m_PrismMesh.nVertices); // Sends vertex or coordinate data to the GPU
 
 	if (m_bMemoryLayoutDone == false)
 	{
@@ -746,7 +448,7 @@ void ShapeMeshes::LoadPyramid3Mesh()
 	glBindVertexArray(m_Pyramid3Mesh.vao);					// Activates the VAO
 	glBindBuffer(GL_ARRAY_BUFFER, m_Pyramid3Mesh.vbos[0]);	// Activates the VBO
 	// Sends vertex or coordinate data to the GPU
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
+	UploadVertexData(verts, m_Pyramid3Mesh.nVertices); // Sends vertex or coordinate data to the GPU
 
 	if (m_bMemoryLayoutDone == false)
 	{
@@ -809,7 +511,7 @@ void ShapeMeshes::LoadPyramid4Mesh()
 	glBindVertexArray(m_Pyramid4Mesh.vao);					// Activates the VAO
 	glBindBuffer(GL_ARRAY_BUFFER, m_Pyramid4Mesh.vbos[0]);	// Activates the VBO
 	// Sends vertex or coordinate data to the GPU
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
+	UploadVertexData(verts, m_Pyramid4Mesh.nVertices); // Sends vertex or coordinate data to the GPU
 
 	if (m_bMemoryLayoutDone == false)
 	{
@@ -1666,7 +1368,7 @@ void ShapeMeshes::LoadSphereMesh()
 	glm::vec3 vert;
 	glm::vec3 center(0.0f, 0.0f, 0.0f);
 	float u, v;
-	std::vector<GLfloat> combined_values;
+	std::vector<GLfloat>& combined_values = BeginMeshScratch().vertexData;
 
 	// combine interleaved vertices, normals, and texture coords
 	for (int i = 0; i < sizeof(verts) / (sizeof(verts[0])); i += 5)
@@ -1692,7 +1394,7 @@ void ShapeMeshes::LoadSphereMesh()
 	// Create VBOs
 	glGenBuffers(2, m_SphereMesh.vbos);
 	glBindBuffer(GL_ARRAY_BUFFER, m_SphereMesh.vbos[0]); // Activates the vertex buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * combined_values.size(), combined_values.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
+	UploadVertexData(combined_values.data(), m_SphereMesh.nVertices); // Sends vertex or coordinate data to the GPU
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_SphereMesh.vbos[1]); // Activates the index buffer
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
@@ -1701,477 +1403,228 @@ void ShapeMeshes::LoadSphereMesh()
 	{
 		SetShaderMemoryLayout();
 	}
+
+	// lower-density variants for distance-based drawing
+	MESH_DATA& lodData = BeginMeshScratch();
+	if (m_pendingSphereLOD1Data.valid())
+	{
+		lodData = m_pendingSphereLOD1Data.get();
+	}
+	else
+	{
+		GenerateSphereMeshData(lodData, g_SphereLOD1Segments);
+	}
+	UploadMeshData(m_SphereLOD1Mesh, lodData);
+
+	BeginMeshScratch();
+	if (m_pendingSphereLOD2Data.valid())
+	{
+		lodData = m_pendingSphereLOD2Data.get();
+	}
+	else
+	{
+		GenerateSphereMeshData(lodData, g_SphereLOD2Segments);
+	}
+	UploadMeshData(m_SphereLOD2Mesh, lodData);
 }
 
 ///////////////////////////////////////////////////
 //	LoadTaperedCylinderMesh()
 //
-//	Create a tapered cylinder mesh by specifying the 
-//  vertices and store it in a VAO/VBO.  The normals 
-//  and texture coordinates are also set.
+//	Create an indexed tapered cylinder mesh and store
+//  it in a VAO/VBO.  The normals and texture
+//  coordinates are also set.
 //
 //  Correct triangle drawing commands:
 //
-//	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-//	glDrawArrays(GL_TRIANGLE_FAN, 36, 72);		//top
-//	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
+//	glDrawElements(GL_TRIANGLES, meshes.gTaperedCylinderMesh.nBottomIndices, GL_UNSIGNED_INT, (void*)0);	//bottom
+//	glDrawElements(GL_TRIANGLES, meshes.gTaperedCylinderMesh.nTopIndices, GL_UNSIGNED_INT, (void*)(meshes.gTaperedCylinderMesh.nBottomIndices * sizeof(GLuint)));	//top
+//	glDrawElements(GL_TRIANGLES, meshes.gTaperedCylinderMesh.nSideIndices, GL_UNSIGNED_INT, (void*)((meshes.gTaperedCylinderMesh.nBottomIndices + meshes.gTaperedCylinderMesh.nTopIndices) * sizeof(GLuint)));	//sides
 ///////////////////////////////////////////////////
 void ShapeMeshes::LoadTaperedCylinderMesh()
 {
-	GLfloat verts[] = {
-		// cylinder bottom		// normals			// texture coords
-		1.0f, 0.0f, 0.0f,		0.0f, -1.0f, 0.0f,	0.5f,1.0f,
-		.98f, 0.0f, -0.17f,		0.0f, -1.0f, 0.0f,	0.41f, 0.983f,
-		.94f, 0.0f, -0.34f,		0.0f, -1.0f, 0.0f,	0.33f, 0.96f,
-		.87f, 0.0f, -0.5f,		0.0f, -1.0f, 0.0f,	0.25f, 0.92f,
-		.77f, 0.0f, -0.64f,		0.0f, -1.0f, 0.0f,	0.17f, 0.87f,
-		.64f, 0.0f, -0.77f,		0.0f, -1.0f, 0.0f,	0.13f, 0.83f,
-		.5f, 0.0f, -0.87f,		0.0f, -1.0f, 0.0f,	0.08f, 0.77f,
-		.34f, 0.0f, -0.94f,		0.0f, -1.0f, 0.0f,	0.04f, 0.68f,
-		.17f, 0.0f, -0.98f,		0.0f, -1.0f, 0.0f,	0.017f, 0.6f,
-		0.0f, 0.0f, -1.0f,		0.0f, -1.0f, 0.0f,	0.0f,0.5f,
-		-.17f, 0.0f, -0.98f,	0.0f, -1.0f, 0.0f,	0.017f, 0.41f,
-		-.34f, 0.0f, -0.94f,	0.0f, -1.0f, 0.0f,	0.04f, 0.33f,
-		-.5f, 0.0f, -0.87f,		0.0f, -1.0f, 0.0f,	0.08f, 0.25f,
-		-.64f, 0.0f, -0.77f,	0.0f, -1.0f, 0.0f,	0.13f, 0.17f,
-		-.77f, 0.0f, -0.64f,	0.0f, -1.0f, 0.0f,	0.17f, 0.13f,
-		-.87f, 0.0f, -0.5f,		0.0f, -1.0f, 0.0f,	0.25f, 0.08f,
-		-.94f, 0.0f, -0.34f,	0.0f, -1.0f, 0.0f,	0.33f, 0.04f,
-		-.98f, 0.0f, -0.17f,	0.0f, -1.0f, 0.0f,	0.41f, 0.017f,
-		-1.0f, 0.0f, 0.0f,		0.0f, -1.0f, 0.0f,	0.5f, 0.0f,
-		-.98f, 0.0f, 0.17f,		0.0f, -1.0f, 0.0f,	0.6f, 0.017f,
-		-.94f, 0.0f, 0.34f,		0.0f, -1.0f, 0.0f,	0.68f, 0.04f,
-		-.87f, 0.0f, 0.5f,		0.0f, -1.0f, 0.0f,	0.77f, 0.08f,
-		-.77f, 0.0f, 0.64f,		0.0f, -1.0f, 0.0f,	0.83f, 0.13f,
-		-.64f, 0.0f, 0.77f,		0.0f, -1.0f, 0.0f,	0.87f, 0.17f,
-		-.5f, 0.0f, 0.87f,		0.0f, -1.0f, 0.0f,	0.92f, 0.25f,
-		-.34f, 0.0f, 0.94f,		0.0f, -1.0f, 0.0f,	0.96f, 0.33f,
-		-.17f, 0.0f, 0.98f,		0.0f, -1.0f, 0.0f,	0.983f, 0.41f,
-		0.0f, 0.0f, 1.0f,		0.0f, -1.0f, 0.0f,	1.0f, 0.5f,
-		.17f, 0.0f, 0.98f,		0.0f, -1.0f, 0.0f,	0.983f, 0.6f,
-		.34f, 0.0f, 0.94f,		0.0f, -1.0f, 0.0f,	0.96f, 0.68f,
-		.5f, 0.0f, 0.87f,		0.0f, -1.0f, 0.0f,	0.92f, 0.77f,
-		.64f, 0.0f, 0.77f,		0.0f, -1.0f, 0.0f,	0.87f, 0.83f,
-		.77f, 0.0f, 0.64f,		0.0f, -1.0f, 0.0f,	0.83f, 0.87f,
-		.87f, 0.0f, 0.5f,		0.0f, -1.0f, 0.0f,	0.77f, 0.92f,
-		.94f, 0.0f, 0.34f,		0.0f, -1.0f, 0.0f,	0.68f, 0.96f,
-		.98f, 0.0f, 0.17f,		0.0f, -1.0f, 0.0f,	0.6f, 0.983f,
-
-		// cylinder top			// normals			// texture coords
-		0.5f, 1.0f, 0.0f,		0.0f, 1.0f, 0.0f,	0.5f,1.0f,
-		.49f, 1.0f, -0.085f,	0.0f, 1.0f, 0.0f,	0.41f, 0.983f,
-		.47f, 1.0f, -0.17f,		0.0f, 1.0f, 0.0f,	0.33f, 0.96f,
-		.435f, 1.0f, -0.25f,	0.0f, 1.0f, 0.0f,	0.25f, 0.92f,
-		.385f, 1.0f, -0.32f,	0.0f, 1.0f, 0.0f,	0.17f, 0.87f,
-		.32f, 1.0f, -0.385f,	0.0f, 1.0f, 0.0f,	0.13f, 0.83f,
-		.25f, 1.0f, -0.435f,	0.0f, 1.0f, 0.0f,	0.08f, 0.77f,
-		.17f, 1.0f, -0.47f,		0.0f, 1.0f, 0.0f,	0.04f, 0.68f,
-		.085f, 1.0f, -0.49f,	0.0f, 1.0f, 0.0f,	0.017f, 0.6f,
-		0.0f, 1.0f, -0.5f,		0.0f, 1.0f, 0.0f,	0.0f,0.5f,
-		-.085f, 1.0f, -0.49f,	0.0f, 1.0f, 0.0f,	0.017f, 0.41f,
-		-.17f, 1.0f, -0.47f,	0.0f, 1.0f, 0.0f,	0.04f, 0.33f,
-		-.25f, 1.0f, -0.435f,	0.0f, 1.0f, 0.0f,	0.08f, 0.25f,
-		-.32f, 1.0f, -0.385f,	0.0f, 1.0f, 0.0f,	0.13f, 0.17f,
-		-.385f, 1.0f, -0.32f,	0.0f, 1.0f, 0.0f,	0.17f, 0.13f,
-		-.435f, 1.0f, -0.25f,	0.0f, 1.0f, 0.0f,	0.25f, 0.08f,
-		-.47f, 1.0f, -0.17f,	0.0f, 1.0f, 0.0f,	0.33f, 0.04f,
-		-.49f, 1.0f, -0.085f,	0.0f, 1.0f, 0.0f,	0.41f, 0.017f,
-		-0.5f, 1.0f, 0.0f,		0.0f, 1.0f, 0.0f,	0.5f, 0.0f,
-		-.49f, 1.0f, 0.085f,	0.0f, 1.0f, 0.0f,	0.6f, 0.017f,
-		-.47f, 1.0f, 0.17f,		0.0f, 1.0f, 0.0f,	0.68f, 0.04f,
-		-.435f, 1.0f, 0.25f,	0.0f, 1.0f, 0.0f,	0.77f, 0.08f,
-		-.385f, 1.0f, 0.32f,	0.0f, 1.0f, 0.0f,	0.83f, 0.13f,
-		-.32f, 1.0f, 0.385f,	0.0f, 1.0f, 0.0f,	0.87f, 0.17f,
-		-.25f, 1.0f, 0.435f,	0.0f, 1.0f, 0.0f,	0.92f, 0.25f,
-		-.17f, 1.0f, 0.47f,		0.0f, 1.0f, 0.0f,	0.96f, 0.33f,
-		-.085f, 1.0f, 0.49f,	0.0f, 1.0f, 0.0f,	0.983f, 0.41f,
-		0.0f, 1.0f, 0.5f,		0.0f, 1.0f, 0.0f,	1.0f, 0.5f,
-		.085f, 1.0f, 0.49f,		0.0f, 1.0f, 0.0f,	0.983f, 0.6f,
-		.17f, 1.0f, 0.47f,		0.0f, 1.0f, 0.0f,	0.96f, 0.68f,
-		.25f, 1.0f, 0.435f,		0.0f, 1.0f, 0.0f,	0.92f, 0.77f,
-		.32f, 1.0f, 0.385f,		0.0f, 1.0f, 0.0f,	0.87f, 0.83f,
-		.385f, 1.0f, 0.32f,		0.0f, 1.0f, 0.0f,	0.83f, 0.87f,
-		.435f, 1.0f, 0.25f,		0.0f, 1.0f, 0.0f,	0.77f, 0.92f,
-		.47f, 1.0f, 0.17f,		0.0f, 1.0f, 0.0f,	0.68f, 0.96f,
-		.49f, 1.0f, 0.085f,		0.0f, 1.0f, 0.0f,	0.6f, 0.983f,
-
-		// cylinder body		// normals							// texture coords
-		0.5f, 1.0f, 0.0f,		0.993150651, 0.5f, -0.116841137f,	0.25,1.0,
-		1.0f, 0.0f, 0.0f,		0.993150651, 0.5f, -0.116841137f,	0.0,0.0,
-		.98f, 0.0f, -0.17f,		0.993150651, 0.5f, -0.116841137f,	0.0277,0.0,
-		0.5f, 1.0f, 0.0f,		0.993150651, 0.5f, -0.116841137f, 	0.25,1.0,
-		.49f, 1.0f, -0.085f,	0.993150651, 0.5f, -0.116841137f, 	0.2635,1.0,
-		.98f, 0.0f, -0.17f,		0.993150651, 0.5f, -0.116841137f,	0.0277,0.0,
-		.94f, 0.0f, -0.34f,		0.993417103f, 0.5f, -0.229039446f,	0.0554,0.0,
-		.49f, 1.0f, -0.085f,	0.993417103f, 0.5f, -0.229039446f,	0.2635,1.0,
-		.47f, 1.0f, -0.17f,		0.993417103f, 0.5f, -0.229039446f,	0.277,1.0,
-		.94f, 0.0f, -0.34f,		0.993417103f, 0.5f, -0.229039446f,	0.0554,0.0,
-		.87f, 0.0f, -0.5f,		0.993417103f, 0.5f, -0.229039446f,	0.0831,0.0,
-		.47f, 1.0f, -0.17f,		0.993417103f, 0.5f, -0.229039446f,	0.277,1.0,
-		.435f, 1.0f, -0.25f,	0.813733339f, 0.5f, -0.581238329f,	0.2905,1.0,
-		.87f, 0.0f, -0.5f,		0.813733339f, 0.5f, -0.581238329f,	0.0831,0.0,
-		.77f, 0.0f, -0.64f,		0.813733339f, 0.5f, -0.581238329f,	0.1108,0.0,
-		.435f, 1.0f, -0.25f,	0.813733339f, 0.5f, -0.581238329f,	0.2905,1.0,
-		.385f, 1.0f, -0.32f,	0.813733339f, 0.5f, -0.581238329f,	0.304,1.0,
-		.77f, 0.0f, -0.64f,		0.813733339f, 0.5f, -0.581238329f,	0.1108,0.0,
-		.64f, 0.0f, -0.77f,		0.707106769f, 0.5f, -0.707106769f,	0.1385,0.0,
-		.385f, 1.0f, -0.32f,	0.707106769f, 0.5f, -0.707106769f,	0.304,1.0,
-		.32f, 1.0f, -0.385f,	0.707106769f, 0.5f, -0.707106769f,	0.3175,1.0,
-		.64f, 0.0f, -0.77f,		0.707106769f, 0.5f, -0.707106769f,	0.1385,0.0,
-		.5f, 0.0f, -0.87f,		0.707106769f, 0.5f, -0.707106769f,	0.1662,0.0,
-		.32f, 1.0f, -0.385f,	0.707106769f, 0.5f, -0.707106769f,	0.3175, 1.0,
-		.25f, 1.0f, -0.435f,	0.400818795f, 0.5f, -0.916157305f,	0.331, 1.0,
-		.5f, 0.0f, -0.87f,		0.400818795f, 0.5f, -0.916157305f,	0.1662, 0.0,
-		.34f, 0.0f, -0.94f,		0.400818795f, 0.5f, -0.916157305f,	0.1939, 0.0,
-		.25f, 1.0f, -0.435f,	0.400818795f, 0.5f, -0.916157305f,	0.331, 1.0,
-		.17f, 1.0f, -0.47f,		0.400818795f, 0.5f, -0.916157305f,	0.3445, 1.0,
-		.34f, 0.0f, -0.94f,		0.400818795f, 0.5f, -0.916157305f,	0.1939, 0.0,
-		.17f, 0.0f, -0.98f,		0.229039446f, 0.5f, -0.973417103f,	0.2216, 0.0,
-		.17f, 1.0f, -0.47f,		0.229039446f, 0.5f, -0.973417103f,	0.3445, 1.0,
-		.085f, 1.0f, -0.49f,	0.229039446f, 0.5f, -0.973417103f,	0.358, 1.0,
-		.17f, 0.0f, -0.98f,		0.229039446f, 0.5f, -0.973417103f,	0.2216, 0.0,
-		0.0f, 0.0f, -1.0f,		0.229039446f, 0.5f, -0.973417103f,	0.2493, 0.0,
-		.085f, 1.0f, -0.49f,	0.229039446f, 0.5f, -0.973417103f,	0.358, 1.0,
-		0.0f, 1.0f, -0.5f,		-0.116841137f, 0.5f, -0.993150651f,	0.3715, 1.0,
-		0.0f, 0.0f, -1.0f,		-0.116841137f, 0.5f, -0.993150651f,	0.2493, 0.0,
-		-.17f, 0.0f, -0.98f,	-0.116841137f, 0.5f, -0.993150651f,	0.277, 0.0,
-		0.0f, 1.0f, -0.5f,		-0.116841137f, 0.5f, -0.993150651f,	0.3715, 1.0,
-		-.085f, 1.0f, -0.49f,	-0.116841137f, 0.5f, -0.993150651f,	0.385, 1.0,
-		-.17f, 0.0f, -0.98f,	-0.116841137f, 0.5f, -0.993150651f,	0.277, 0.0,
-		-.34f, 0.0f, -0.94f,	-0.229039446f, 0.5f, -0.973417103f,	0.3047, 0.0,
-		-.085f, 1.0f, -0.49f,	-0.229039446f, 0.5f, -0.973417103f,	0.385, 1.0,
-		-.17f, 1.0f, -0.47f,	-0.229039446f, 0.5f, -0.973417103f,	0.3985, 1.0,
-		-.34f, 0.0f, -0.94f,	-0.229039446f, 0.5f, -0.973417103f,	0.3047, 0.0,
-		-.5f, 0.0f, -0.87f,		-0.229039446f, 0.5f, -0.973417103f,	0.3324, 0.0,
-		-.17f, 1.0f, -0.47f,	-0.229039446f, 0.5f, -0.973417103f,	0.3985, 1.0,
-		-.25f, 1.0f, -0.435f,	-0.581238329f, 0.5f, -0.581238329f,	0.412, 1.0,
-		-.5f, 0.0f, -0.87f,		-0.581238329f, 0.5f, -0.581238329f,	0.3324, 0.0,
-		-.64f, 0.0f, -0.77f,	-0.581238329f, 0.5f, -0.581238329f,	0.3601, 0.0,
-		-.25f, 1.0f, -0.435f,	-0.581238329f, 0.5f, -0.581238329f,	0.412, 1.0,
-		-.32f, 1.0f, -0.385f,	-0.581238329f, 0.5f, -0.581238329f,	0.4255, 1.0,
-		-.64f, 0.0f, -0.77f,	-0.581238329f, 0.5f, -0.581238329f,	0.3601, 0.0,
-		-.77f, 0.0f, -0.64f,	-0.707106769f, 0.5f, -0.707106769f,	0.3878, 0.0,
-		-.32f, 1.0f, -0.385f,	-0.707106769f, 0.5f, -0.707106769f,	0.4255, 1.0,
-		-.385f, 1.0f, -0.32f,	-0.707106769f, 0.5f, -0.707106769f,	0.439, 1.0,
-		-.77f, 0.0f, -0.64f,	-0.707106769f, 0.5f, -0.707106769f,	0.3878, 0.0,
-		-.87f, 0.0f, -0.5f,		-0.707106769f, 0.5f, -0.707106769f,	0.4155, 0.0,
-		-.385f, 1.0f, -0.32f,	-0.707106769f, 0.5f, -0.707106769f,	0.439, 1.0,
-		-.435f, 1.0f, -0.25f,	-0.916157305f, 0.5f, -0.400818795f,	0.4525, 1.0,
-		-.87f, 0.0f, -0.5f,		-0.916157305f, 0.5f, -0.400818795f,	0.4155, 0.0,
-		-.94f, 0.0f, -0.34f,	-0.916157305f, 0.5f, -0.400818795f,	0.4432, 0.0,
-		-.435f, 1.0f, -0.25f,	-0.916157305f, 0.5f, -0.400818795f,	0.4525, 1.0,
-		-.47f, 1.0f, -0.17f,	-0.916157305f, 0.5f, -0.400818795f,	0.466, 1.0,
-		-.94f, 0.0f, -0.34f,	-0.916157305f, 0.5f, -0.400818795f,	0.4432, 0.0,
-		-.98f, 0.0f, -0.17f,	-0.973417103f, 0.5f, -0.229039446f,	0.4709, 0.0,
-		-.47f, 1.0f, -0.17f,	-0.973417103f, 0.5f, -0.229039446f,	0.466, 1.0,
-		-.49f, 1.0f, -0.085f,	-0.973417103f, 0.5f, -0.229039446f,	0.4795, 1.0,
-		-.98f, 0.0f, -0.17f,	-0.973417103f, 0.5f, -0.229039446f,	0.4709, 0.0,
-		-1.0f, 0.0f, 0.0f,		-0.973417103f, 0.5f, -0.229039446f,	0.4986, 0.0,
-		-.49f, 1.0f, -0.085f,	-0.973417103f, 0.5f, -0.229039446f,	0.4795, 1.0,
-		-0.5f, 1.0f, 0.0f,		-0.993150651f, 0.5f, -0.116841137f,	0.493, 1.0,
-		-1.0f, 0.0f, 0.0f,		-0.993150651f, 0.5f, -0.116841137f,	0.4986, 0.0,
-		-.98f, 0.0f, 0.17f,		-0.993150651f, 0.5f, 0.116841137f,	0.5263, 0.0,
-		-0.5f, 1.0f, 0.0f,		-0.993150651f, 0.5f, 0.116841137f,	0.493, 1.0,
-		-.49f, 1.0f, 0.085f,	-0.993150651f, 0.5f, 0.116841137f,	0.5065, 1.0,
-		-.98f, 0.0f, 0.17f,		-0.993150651f, 0.5f, 0.116841137f,	0.5263, 0.0,
-		-.94f, 0.0f, 0.34f,		-0.973417103f, 0.5f, 0.229039446f,	0.554, 0.0,
-		-.49f, 1.0f, 0.085f,	-0.973417103f, 0.5f, 0.229039446f,	0.5065, 1.0,
-		-.47f, 1.0f, 0.17f,		-0.973417103f, 0.5f, 0.229039446f,	0.52, 1.0,
-		-.94f, 0.0f, 0.34f,		-0.973417103f, 0.5f, 0.229039446f,	0.554, 0.0,
-		-.87f, 0.0f, 0.5f,		-0.973417103f, 0.5f, 0.229039446f,	0.5817, 0.0,
-		-.47f, 1.0f, 0.17f,		-0.973417103f, 0.5f, 0.229039446f,	0.52, 1.0,
-		-.435f, 1.0f, 0.25f,	-0.813733339f, 0.5f, 0.581238329f,	0.5335, 1.0,
-		-.87f, 0.0f, 0.5f,		-0.813733339f, 0.5f, 0.581238329f,	0.5817, 0.0,
-		-.77f, 0.0f, 0.64f,		-0.813733339f, 0.5f, 0.581238329f,	0.6094, 0.0,
-		-.435f, 1.0f, 0.25f,	-0.813733339f, 0.5f, 0.581238329f,	0.5335, 1.0,
-		-.385f, 1.0f, 0.32f,	-0.813733339f, 0.5f, 0.581238329f,	0.547, 1.0,
-		-.77f, 0.0f, 0.64f,		-0.813733339f, 0.5f, 0.581238329f,	0.6094, 0.0,
-		-.64f, 0.0f, 0.77f,		-0.707106769f, 0.5f, 0.707106769f,	0.6371, 0.0,
-		-.385f, 1.0f, 0.32f,	-0.707106769f, 0.5f, 0.707106769f,	0.547, 1.0,
-		-.32f, 1.0f, 0.385f,	-0.707106769f, 0.5f, 0.707106769f,	0.5605, 1.0,
-		-.64f, 0.0f, 0.77f,		-0.707106769f, 0.5f, 0.707106769f,	0.6371, 0.0,
-		-.5f, 0.0f, 0.87f,		-0.707106769f, 0.5f, 0.707106769f,	0.6648, 0.0,
-		-.32f, 1.0f, 0.385f,	-0.707106769f, 0.5f, 0.707106769f,	0.5605, 1.0,
-		-.25f, 1.0f, 0.435f,	-0.400818795f, 0.5f, 0.916157305f,	0.574, 1.0,
-		-.5f, 0.0f, 0.87f,		-0.400818795f, 0.5f, 0.916157305f,	0.6648, 0.0,
-		-.34f, 0.0f, 0.94f,		-0.400818795f, 0.5f, 0.916157305f,	0.6925, 0.0,
-		-.25f, 1.0f, 0.435f,	-0.400818795f, 0.5f, 0.916157305f,	0.574, 1.0,
-		-.17f, 1.0f, 0.47f,		-0.400818795f, 0.5f, 0.916157305f,	0.5875, 1.0,
-		-.34f, 0.0f, 0.94f,		-0.400818795f, 0.5f, 0.916157305f,	0.6925, 0.0,
-		-.17f, 0.0f, 0.98f,		-0.229039446f, 0.5f, 0.973417103f,	0.7202, 0.0,
-		-.17f, 1.0f, 0.47f,		-0.229039446f, 0.5f, 0.973417103f,	0.5875, 1.0,
-		-.085f, 1.0f, 0.49f,	-0.229039446f, 0.5f, 0.973417103f,	0.601, 1.0,
-		-.17f, 0.0f, 0.98f,		-0.229039446f, 0.5f, 0.973417103f,	0.7202, 0.0,
-		0.0f, 0.0f, 1.0f,		-0.229039446f, 0.5f, 0.973417103f,	0.7479, 0.0,
-		-.085f, 1.0f, 0.49f,	-0.229039446f, 0.5f, 0.973417103f,	0.601, 1.0,
-		0.0f, 1.0f, 0.5f,		-0.116841137f, 0.5f, 0.993150651f,	0.6145, 1.0,
-		0.0f, 0.0f, 1.0f,		-0.116841137f, 0.5f, 0.993150651f,	0.7479, 0.0,
-		.17f, 0.0f, 0.98f,		0.116841137f, 0.5f, 0.993150651f,	0.7756, 0.0,
-		0.0f, 1.0f, 0.5f,		0.116841137f, 0.5f, 0.993150651f,	0.6145, 1.0,
-		.085f, 1.0f, 0.49f,		0.116841137f, 0.5f, 0.993150651f,	0.628, 1.0,
-		.17f, 0.0f, 0.98f,		0.116841137f, 0.5f, 0.993150651f,	0.7756, 0.0,
-		.34f, 0.0f, 0.94f,		0.229039446f, 0.5f, 0.973417103f,	0.8033, 0.0,
-		.085f, 1.0f, 0.49f,		0.229039446f, 0.5f, 0.973417103f,	0.628, 1.0,
-		.17f, 1.0f, 0.47f,		0.229039446f, 0.5f, 0.973417103f,	0.6415, 1.0,
-		.34f, 0.0f, 0.94f,		0.229039446f, 0.5f, 0.973417103f,	0.8033, 0.0,
-		.5f, 0.0f, 0.87f,		0.229039446f, 0.5f, 0.973417103f,	0.831, 0.0,
-		.17f, 1.0f, 0.47f,		0.229039446f, 0.5f, 0.973417103f,	0.6415, 1.0,
-		.25f, 1.0f, 0.435f,		0.581238329f, 0.5f, 0.813733339f,	0.655, 1.0,
-		.5f, 0.0f, 0.87f,		0.581238329f, 0.5f, 0.813733339f,	0.831, 0.0,
-		.64f, 0.0f, 0.77f,		0.581238329f, 0.5f, 0.813733339f,	0.8587, 0.0,
-		.25f, 1.0f, 0.435f,		0.581238329f, 0.5f, 0.813733339f,	0.655, 1.0,
-		.32f, 1.0f, 0.385f,		0.581238329f, 0.5f, 0.813733339f,	0.6685, 1.0,
-		.64f, 0.0f, 0.77f,		0.581238329f, 0.5f, 0.813733339f,	0.8587, 0.0,
-		.77f, 0.0f, 0.64f,		0.707106769f, 0.5f, 0.707106769f,	0.8864, 0.0,
-		.32f, 1.0f, 0.385f,		0.707106769f, 0.5f, 0.707106769f,	0.6685, 1.0,
-		.385f, 1.0f, 0.32f,		0.707106769f, 0.5f, 0.707106769f,	0.682, 1.0,
-		.77f, 0.0f, 0.64f,		0.707106769f, 0.5f, 0.707106769f,	0.8864, 0.0,
-		.87f, 0.0f, 0.5f,		0.707106769f, 0.5f, 0.707106769f,	0.9141, 0.0,
-		.385f, 1.0f, 0.32f,		0.707106769f, 0.5f, 0.707106769f,	0.682, 1.0,
-		.435f, 1.0f, 0.25f,		0.916157305f, 0.5f, 0.400818795f,	0.6955, 1.0,
-		.87f, 0.0f, 0.5f,		0.916157305f, 0.5f, 0.400818795f,	0.9141, 0.0,
-		.94f, 0.0f, 0.34f,		0.916157305f, 0.5f, 0.400818795f,	0.9418, 0.0,
-		.435f, 1.0f, 0.25f,		0.916157305f, 0.5f, 0.400818795f,	0.6955, 1.0,
-		.47f, 1.0f, 0.17f,		0.916157305f, 0.5f, 0.400818795f,	0.709, 1.0,
-		.94f, 0.0f, 0.34f,		0.916157305f, 0.5f, 0.400818795f,	0.9418, 1.0,
-		.98f, 0.0f, 0.17f,		0.973417103f, 0.5f, 0.229039446f,	0.9695, 0.0,
-		.47f, 1.0f, 0.17f,		0.973417103f, 0.5f, 0.229039446f,	0.709, 0.0,
-		.49f, 1.0f, 0.085f,		0.973417103f, 0.5f, 0.229039446f,	0.7225, 1.0,
-		.98f, 0.0f, 0.17f,		0.973417103f, 0.5f, 0.229039446f,	0.9695, 0.0,
-		1.0f, 0.0f, 0.0f,		0.973417103f, 0.5f, 0.229039446f,	1.0, 0.0,
-		.49f, 1.0f, 0.085f,		0.973417103f, 0.5f, 0.229039446f,	0.7225, 1.0,
-		0.5f, 1.0f, 0.0f,		0.993150651f, 0.5f, 0.116841137f,	0.75, 1.0,
-		1.0f, 0.0f, 0.0f,		0.993150651f, 0.5f, 0.116841137f,	1.0, 0.0
-	};
-
-	// store vertex and index count
-	m_TaperedCylinderMesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (g_FloatsPerVertex + g_FloatsPerNormal + g_FloatsPerUV));
-	m_TaperedCylinderMesh.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &m_TaperedCylinderMesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(m_TaperedCylinderMesh.vao);
-
-	// Create VBO
-	glGenBuffers(1, m_TaperedCylinderMesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, m_TaperedCylinderMesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	if (m_bMemoryLayoutDone == false)
+	MESH_DATA& data = BeginMeshScratch();
+	if (m_pendingTaperedCylinderData.valid())
 	{
-		SetShaderMemoryLayout();
+		data = m_pendingTaperedCylinderData.get();
 	}
+	else
+	{
+		GenerateConicMeshData(data, 1.0f, 0.5f, true);
+	}
+	UploadMeshData(m_TaperedCylinderMesh, data);
 }
 
 ///////////////////////////////////////////////////
 //	LoadTorusMesh()
 //
-//	Create a torus mesh by specifying the vertices and 
-//  store it in a VAO/VBO.  The normals and texture
-//  coordinates are also set.
+//	Register the tube thickness for the default torus
+//  and generate its cached mesh variants.  The meshes
+//  are shared through the torus cache with any other
+//  request for the same thickness and tessellation.
+///////////////////////////////////////////////////
+void ShapeMeshes::LoadTorusMesh(float thickness)
+{
+	m_torusThickness = thickness;
+
+	// the default torus and its distance variants are drawn every
+	// frame, so generate them now - before the mesh buffers may be
+	// consolidated - instead of on the first draw
+	GetTorusMesh(thickness, g_TorusSegments, g_TorusSegments);
+	GetTorusMesh(thickness, g_TorusLOD1MainSegments, g_TorusLOD1TubeSegments);
+	GetTorusMesh(thickness, g_TorusLOD2MainSegments, g_TorusLOD2TubeSegments);
+}
+
+///////////////////////////////////////////////////
+//	LoadExtraTorusMesh1()
 //
-//	Correct triangle drawing command:
+//	Register the tube thickness for the extra torus.
+//  The mesh itself comes from the shared torus cache
+//  when DrawExtraTorusMesh1() first needs it.
+///////////////////////////////////////////////////
+void ShapeMeshes::LoadExtraTorusMesh1(float thickness)
+{
+	// generation is deferred until the mesh is first drawn
+	m_extraTorus1Thickness = thickness;
+}
+
+///////////////////////////////////////////////////
+//	LoadExtraTorusMesh2()
 //
-//	glDrawArrays(GL_TRIANGLES, 0, meshes.gTorusMesh.nVertices);
+//	Register the tube thickness for the extra torus.
+//  The mesh itself comes from the shared torus cache
+//  when DrawExtraTorusMesh2() first needs it.
 ///////////////////////////////////////////////////
-void ShapeMeshes::LoadTorusMesh(float thickness)
+void ShapeMeshes::LoadExtraTorusMesh2(float thickness)
 {
-	int _mainSegments = 30;
-	int _tubeSegments = 30;
-	float _mainRadius = 1.0f;
-	float _tubeRadius = .1f;
+	// generation is deferred until the mesh is first drawn
+	m_extraTorus2Thickness = thickness;
+}
 
-	if (thickness <= 1.0)
+///////////////////////////////////////////////////
+//	GenerateConicMeshData()
+//
+//	Generate the indexed mesh data for a cylinder,
+//  cone, or tapered cylinder from the passed in bottom
+//  and top radius.  The ring vertices are shared
+//  between the triangles through the index buffer and
+//  the parts (bottom cap, top cap, sides) are stored
+//  back to back in the index list so they can be drawn
+//  separately.  Runs entirely on the CPU so it can be
+//  called from a worker thread.
+///////////////////////////////////////////////////
+void ShapeMeshes::GenerateConicMeshData(
+	MESH_DATA& data,
+	float bottomRadius,
+	float topRadius,
+	bool bHasTopCap)
+{
+	const int _segments = 36;
+	float angleStep = glm::radians(360.0f / float(_segments));
+	glm::vec3 sideNormal;
+
+	data.nBottomIndices = 0;
+	data.nTopIndices = 0;
+	data.nSideIndices = 0;
+
+	// bottom cap - the center point followed by the edge ring
+	data.vertexData.insert(data.vertexData.end(),
+		{ 0.0f, 0.0f, 0.0f,  0.0f, -1.0f, 0.0f,  0.5f, 0.5f });
+	for (int i = 0; i < _segments; i++)
 	{
-		_tubeRadius = thickness;
+		float cosSegment = cos(float(i) * angleStep);
+		float sinSegment = sin(float(i) * angleStep);
+		data.vertexData.insert(data.vertexData.end(),
+			{ bottomRadius * cosSegment, 0.0f, bottomRadius * sinSegment,
+			0.0f, -1.0f, 0.0f,
+			0.5f + 0.5f * sinSegment, 0.5f + 0.5f * cosSegment });
 	}
-
-	auto mainSegmentAngleStep = glm::radians(360.0f / float(_mainSegments));
-	auto tubeSegmentAngleStep = glm::radians(360.0f / float(_tubeSegments));
-
-	std::vector<glm::vec3> vertex_list;
-	std::vector<std::vector<glm::vec3>> segments_list;
-	std::vector<glm::vec2> texture_coords;
-	glm::vec3 center(0.0f, 0.0f, 0.0f);
-	glm::vec3 normal;
-	glm::vec3 vertex;
-	glm::vec2 text_coord;
-
-	// generate the torus vertices
-	auto currentMainSegmentAngle = 0.0f;
-	for (auto i = 0; i < _mainSegments; i++)
-	{
-		// Calculate sine and cosine of main segment angle
-		auto sinMainSegment = sin(currentMainSegmentAngle);
-		auto cosMainSegment = cos(currentMainSegmentAngle);
-		auto currentTubeSegmentAngle = 0.0f;
-		std::vector<glm::vec3> segment_points;
-		for (auto j = 0; j < _tubeSegments; j++)
-		{
-			// Calculate sine and cosine of tube segment angle
-			auto sinTubeSegment = sin(currentTubeSegmentAngle);
-			auto cosTubeSegment = cos(currentTubeSegmentAngle);
-
-			// Calculate vertex position on the surface of torus
-			auto surfacePosition = glm::vec3(
-				(_mainRadius + _tubeRadius * cosTubeSegment) * cosMainSegment,
-				(_mainRadius + _tubeRadius * cosTubeSegment) * sinMainSegment,
-				_tubeRadius * sinTubeSegment);
-
-			//vertex_list.push_back(surfacePosition);
-			segment_points.push_back(surfacePosition);
-
-			// Update current tube angle
-			currentTubeSegmentAngle += tubeSegmentAngleStep;
-		}
-		segments_list.push_back(segment_points);
-		segment_points.clear();
-
-		// Update main segment angle
-		currentMainSegmentAngle += mainSegmentAngleStep;
+	for (int i = 0; i < _segments; i++)
+	{
+		data.indexData.push_back(0);
+		data.indexData.push_back(1 + i);
+		data.indexData.push_back(1 + ((i + 1) % _segments));
 	}
+	data.nBottomIndices = _segments * 3;
 
-	float horizontalStep = 1.0 / _mainSegments;
-	float verticalStep = 1.0 / _tubeSegments;
-	float u = 0.0;
-	float v = 0.0;
-
-	// connect the various segments together, forming triangles
-	for (int i = 0; i < _mainSegments; i++)
+	// top cap - only present when the shape is not a cone
+	if (bHasTopCap == true)
 	{
-		for (int j = 0; j < _tubeSegments; j++)
+		GLuint topCenter = (GLuint)(data.vertexData.size() / (g_FloatsPerVertex + g_FloatsPerNormal + g_FloatsPerUV));
+		data.vertexData.insert(data.vertexData.end(),
+			{ 0.0f, 1.0f, 0.0f,  0.0f, 1.0f, 0.0f,  0.5f, 0.5f });
+		for (int i = 0; i < _segments; i++)
 		{
-			if (((i + 1) < _mainSegments) && ((j + 1) < _tubeSegments))
-			{
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-				vertex_list.push_back(segments_list[i][j + 1]);
-				texture_coords.push_back(glm::vec2(u, v + verticalStep));
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v + verticalStep));
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-				vertex_list.push_back(segments_list[i + 1][j]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v));
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v - verticalStep));
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-			}
-			else
-			{
-				if (((i + 1) == _mainSegments) && ((j + 1) == _tubeSegments))
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][0]);
-					texture_coords.push_back(glm::vec2(u, 0));
-					vertex_list.push_back(segments_list[0][0]);
-					texture_coords.push_back(glm::vec2(0, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[0][j]);
-					texture_coords.push_back(glm::vec2(0, v));
-					vertex_list.push_back(segments_list[0][0]);
-					texture_coords.push_back(glm::vec2(0, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-				else if ((i + 1) == _mainSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][j + 1]);
-					texture_coords.push_back(glm::vec2(u, v + verticalStep));
-					vertex_list.push_back(segments_list[0][j + 1]);
-					texture_coords.push_back(glm::vec2(0, v + verticalStep));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[0][j]);
-					texture_coords.push_back(glm::vec2(0, v));
-					vertex_list.push_back(segments_list[0][j + 1]);
-					texture_coords.push_back(glm::vec2(0, v + verticalStep));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-				else if ((j + 1) == _tubeSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][0]);
-					texture_coords.push_back(glm::vec2(u, 0));
-					vertex_list.push_back(segments_list[i + 1][0]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i + 1][j]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, v));
-					vertex_list.push_back(segments_list[i + 1][0]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-
-			}
-			v += verticalStep;
+			float cosSegment = cos(float(i) * angleStep);
+			float sinSegment = sin(float(i) * angleStep);
+			data.vertexData.insert(data.vertexData.end(),
+				{ topRadius * cosSegment, 1.0f, topRadius * sinSegment,
+				0.0f, 1.0f, 0.0f,
+				0.5f + 0.5f * sinSegment, 0.5f + 0.5f * cosSegment });
+		}
+		for (int i = 0; i < _segments; i++)
+		{
+			data.indexData.push_back(topCenter);
+			data.indexData.push_back(topCenter + 1 + i);
+			data.indexData.push_back(topCenter + 1 + ((i + 1) % _segments));
 		}
-		v = 0.0;
-		u += horizontalStep;
+		data.nTopIndices = _segments * 3;
 	}
 
-	std::vector<GLfloat> combined_values;
-
-	// combine interleaved vertices, normals, and texture coords
-	for (int i = 0; i < vertex_list.size(); i++)
+	// sides - the seam column is duplicated so the texture
+	// coordinates can wrap around the shape cleanly
+	GLuint firstSideVertex = (GLuint)(data.vertexData.size() / (g_FloatsPerVertex + g_FloatsPerNormal + g_FloatsPerUV));
+	for (int i = 0; i <= _segments; i++)
 	{
-		vertex = vertex_list[i];
-		normal = normalize(vertex);
-
-		text_coord = texture_coords[i];
-		combined_values.push_back(vertex.x);
-		combined_values.push_back(vertex.y);
-		combined_values.push_back(vertex.z);
-		combined_values.push_back(normal.x);
-		combined_values.push_back(normal.y);
-		combined_values.push_back(normal.z);
-		combined_values.push_back(text_coord.x);
-		combined_values.push_back(text_coord.y);
+		float cosSegment = cos(float(i % _segments) * angleStep);
+		float sinSegment = sin(float(i % _segments) * angleStep);
+		float u = float(i) / float(_segments);
+
+		// the slope of the sides tilts the side normals
+		sideNormal = glm::normalize(
+			glm::vec3(cosSegment, bottomRadius - topRadius, sinSegment));
+
+		data.vertexData.insert(data.vertexData.end(),
+			{ bottomRadius * cosSegment, 0.0f, bottomRadius * sinSegment,
+			sideNormal.x, sideNormal.y, sideNormal.z,
+			u, 0.0f });
+		data.vertexData.insert(data.vertexData.end(),
+			{ topRadius * cosSegment, 1.0f, topRadius * sinSegment,
+			sideNormal.x, sideNormal.y, sideNormal.z,
+			u, 1.0f });
 	}
-
-	// store vertex and index count
-	m_TorusMesh.nVertices = vertex_list.size();
-	m_TorusMesh.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &m_TorusMesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(m_TorusMesh.vao);
-
-	// Create VBOs
-	glGenBuffers(1, m_TorusMesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, m_TorusMesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * combined_values.size(), combined_values.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	if (m_bMemoryLayoutDone == false)
+	for (int i = 0; i < _segments; i++)
 	{
-		SetShaderMemoryLayout();
+		GLuint bottomLeft = firstSideVertex + (GLuint)(i * 2);
+		data.indexData.push_back(bottomLeft);
+		data.indexData.push_back(bottomLeft + 1);
+		data.indexData.push_back(bottomLeft + 2);
+		data.indexData.push_back(bottomLeft + 2);
+		data.indexData.push_back(bottomLeft + 1);
+		data.indexData.push_back(bottomLeft + 3);
 	}
+	data.nSideIndices = _segments * 6;
 }
 
 ///////////////////////////////////////////////////
-//	LoadExtraTorusMesh1()
-//
-//	Create a torus mesh by specifying the vertices and 
-//  store it in a VAO/VBO.  The normals and texture
-//  coordinates are also set.
-//
-//	Correct triangle drawing command:
+//	GenerateTorusMeshData()
 //
-//	glDrawArrays(GL_TRIANGLES, 0, meshes.gExtraTorusMesh1.nVertices);
-///////////////////////////////////////////////////
-void ShapeMeshes::LoadExtraTorusMesh1(float thickness)
+//	Generate the indexed torus mesh data with the
+//  passed in tube thickness and tessellation density.
+//  Each ring vertex is stored once and shared between
+//  its triangles through the index buffer, with the
+//  seam ring and seam column duplicated so the texture
+//  coordinates can wrap.  Runs entirely on the CPU so
+//  it can be called from a worker thread.
+///////////////////////////////////////////////////
+void ShapeMeshes::GenerateTorusMeshData(
+	MESH_DATA& data,
+	float thickness,
+	int mainSegments,
+	int tubeSegments)
 {
-	int _mainSegments = 30;
-	int _tubeSegments = 30;
+	int _mainSegments = mainSegments;
+	int _tubeSegments = tubeSegments;
 	float _mainRadius = 1.0f;
 	float _tubeRadius = .1f;
 
@@ -2183,361 +1636,210 @@ void ShapeMeshes::LoadExtraTorusMesh1(float thickness)
 	auto mainSegmentAngleStep = glm::radians(360.0f / float(_mainSegments));
 	auto tubeSegmentAngleStep = glm::radians(360.0f / float(_tubeSegments));
 
-	std::vector<glm::vec3> vertex_list;
-	std::vector<std::vector<glm::vec3>> segments_list;
-	std::vector<glm::vec2> texture_coords;
-	glm::vec3 center(0.0f, 0.0f, 0.0f);
 	glm::vec3 normal;
 	glm::vec3 vertex;
-	glm::vec2 text_coord;
-
-	// generate the torus vertices
-	auto currentMainSegmentAngle = 0.0f;
-	for (auto i = 0; i < _mainSegments; i++)
-	{
-		// Calculate sine and cosine of main segment angle
-		auto sinMainSegment = sin(currentMainSegmentAngle);
-		auto cosMainSegment = cos(currentMainSegmentAngle);
-		auto currentTubeSegmentAngle = 0.0f;
-		std::vector<glm::vec3> segment_points;
-		for (auto j = 0; j < _tubeSegments; j++)
+
+	data.nBottomIndices = 0;
+	data.nTopIndices = 0;
+	data.nSideIndices = 0;
+
+	// generate the torus vertex rings
+	for (int i = 0; i <= _mainSegments; i++)
+	{
+		auto sinMainSegment = sin(float(i % _mainSegments) * mainSegmentAngleStep);
+		auto cosMainSegment = cos(float(i % _mainSegments) * mainSegmentAngleStep);
+		for (int j = 0; j <= _tubeSegments; j++)
 		{
-			// Calculate sine and cosine of tube segment angle
-			auto sinTubeSegment = sin(currentTubeSegmentAngle);
-			auto cosTubeSegment = cos(currentTubeSegmentAngle);
+			auto sinTubeSegment = sin(float(j % _tubeSegments) * tubeSegmentAngleStep);
+			auto cosTubeSegment = cos(float(j % _tubeSegments) * tubeSegmentAngleStep);
 
 			// Calculate vertex position on the surface of torus
-			auto surfacePosition = glm::vec3(
+			vertex = glm::vec3(
 				(_mainRadius + _tubeRadius * cosTubeSegment) * cosMainSegment,
 				(_mainRadius + _tubeRadius * cosTubeSegment) * sinMainSegment,
 				_tubeRadius * sinTubeSegment);
-
-			//vertex_list.push_back(surfacePosition);
-			segment_points.push_back(surfacePosition);
-
-			// Update current tube angle
-			currentTubeSegmentAngle += tubeSegmentAngleStep;
+			normal = normalize(vertex);
+
+			data.vertexData.push_back(vertex.x);
+			data.vertexData.push_back(vertex.y);
+			data.vertexData.push_back(vertex.z);
+			data.vertexData.push_back(normal.x);
+			data.vertexData.push_back(normal.y);
+			data.vertexData.push_back(normal.z);
+			data.vertexData.push_back(float(i) / float(_mainSegments));
+			data.vertexData.push_back(float(j) / float(_tubeSegments));
 		}
-		segments_list.push_back(segment_points);
-		segment_points.clear();
-
-		// Update main segment angle
-		currentMainSegmentAngle += mainSegmentAngleStep;
 	}
 
-	float horizontalStep = 1.0 / _mainSegments;
-	float verticalStep = 1.0 / _tubeSegments;
-	float u = 0.0;
-	float v = 0.0;
-
-	// connect the various segments together, forming triangles
+	// connect the rings, keeping the indices ordered by main
+	// segment so the first half of the list is half of the torus
 	for (int i = 0; i < _mainSegments; i++)
 	{
 		for (int j = 0; j < _tubeSegments; j++)
 		{
-			if (((i + 1) < _mainSegments) && ((j + 1) < _tubeSegments))
-			{
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-				vertex_list.push_back(segments_list[i][j + 1]);
-				texture_coords.push_back(glm::vec2(u, v + verticalStep));
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v + verticalStep));
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-				vertex_list.push_back(segments_list[i + 1][j]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v));
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v - verticalStep));
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-			}
-			else
-			{
-				if (((i + 1) == _mainSegments) && ((j + 1) == _tubeSegments))
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][0]);
-					texture_coords.push_back(glm::vec2(u, 0));
-					vertex_list.push_back(segments_list[0][0]);
-					texture_coords.push_back(glm::vec2(0, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[0][j]);
-					texture_coords.push_back(glm::vec2(0, v));
-					vertex_list.push_back(segments_list[0][0]);
-					texture_coords.push_back(glm::vec2(0, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-				else if ((i + 1) == _mainSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][j + 1]);
-					texture_coords.push_back(glm::vec2(u, v + verticalStep));
-					vertex_list.push_back(segments_list[0][j + 1]);
-					texture_coords.push_back(glm::vec2(0, v + verticalStep));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[0][j]);
-					texture_coords.push_back(glm::vec2(0, v));
-					vertex_list.push_back(segments_list[0][j + 1]);
-					texture_coords.push_back(glm::vec2(0, v + verticalStep));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-				else if ((j + 1) == _tubeSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][0]);
-					texture_coords.push_back(glm::vec2(u, 0));
-					vertex_list.push_back(segments_list[i + 1][0]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i + 1][j]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, v));
-					vertex_list.push_back(segments_list[i + 1][0]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-
-			}
-			v += verticalStep;
+			GLuint current = (GLuint)(i * (_tubeSegments + 1) + j);
+			GLuint next = current + (GLuint)(_tubeSegments + 1);
+
+			data.indexData.push_back(current);
+			data.indexData.push_back(current + 1);
+			data.indexData.push_back(next + 1);
+			data.indexData.push_back(current);
+			data.indexData.push_back(next);
+			data.indexData.push_back(next + 1);
 		}
-		v = 0.0;
-		u += horizontalStep;
-	}
-
-	std::vector<GLfloat> combined_values;
-
-	// combine interleaved vertices, normals, and texture coords
-	for (int i = 0; i < vertex_list.size(); i++)
-	{
-		vertex = vertex_list[i];
-		normal = normalize(vertex);
-
-		text_coord = texture_coords[i];
-		combined_values.push_back(vertex.x);
-		combined_values.push_back(vertex.y);
-		combined_values.push_back(vertex.z);
-		combined_values.push_back(normal.x);
-		combined_values.push_back(normal.y);
-		combined_values.push_back(normal.z);
-		combined_values.push_back(text_coord.x);
-		combined_values.push_back(text_coord.y);
-	}
-
-	// store vertex and index count
-	m_ExtraTorusMesh1.nVertices = vertex_list.size();
-	m_ExtraTorusMesh1.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &m_ExtraTorusMesh1.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(m_ExtraTorusMesh1.vao);
-
-	// Create VBOs
-	glGenBuffers(1, m_ExtraTorusMesh1.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, m_ExtraTorusMesh1.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * combined_values.size(), combined_values.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	if (m_bMemoryLayoutDone == false)
-	{
-		SetShaderMemoryLayout();
 	}
+	data.nSideIndices = (GLuint)data.indexData.size();
 }
 
 ///////////////////////////////////////////////////
-//	LoadExtraTorusMesh2()
-//
-//	Create a torus mesh by specifying the vertices and 
-//  store it in a VAO/VBO.  The normals and texture
-//  coordinates are also set.
+//	GetTorusMesh()
 //
-//	Correct triangle drawing command:
-//
-//	glDrawArrays(GL_TRIANGLES, 0, meshes.gExtraTorusMesh1.nVertices);
-///////////////////////////////////////////////////
-void ShapeMeshes::LoadExtraTorusMesh2(float thickness)
+//	Find the cached torus mesh with the passed in
+//  thickness and tessellation, generating it on the
+//  first request.
+///////////////////////////////////////////////////
+ShapeMeshes::GLMesh& ShapeMeshes::GetTorusMesh(
+	float thickness,
+	int mainSegments,
+	int tubeSegments)
 {
-	int _mainSegments = 30;
-	int _tubeSegments = 30;
-	float _mainRadius = 1.0f;
-	float _tubeRadius = .1f;
-
-	if (thickness <= 1.0)
+	for (int i = 0; i < (int)m_torusMeshes.size(); i++)
 	{
-		_tubeRadius = thickness;
+		if ((m_torusMeshes[i].thickness == thickness) &&
+			(m_torusMeshes[i].mainSegments == mainSegments) &&
+			(m_torusMeshes[i].tubeSegments == tubeSegments))
+		{
+			return m_torusMeshes[i].mesh;
+		}
 	}
 
-	auto mainSegmentAngleStep = glm::radians(360.0f / float(_mainSegments));
-	auto tubeSegmentAngleStep = glm::radians(360.0f / float(_tubeSegments));
-
-	std::vector<glm::vec3> vertex_list;
-	std::vector<std::vector<glm::vec3>> segments_list;
-	std::vector<glm::vec2> texture_coords;
-	glm::vec3 center(0.0f, 0.0f, 0.0f);
-	glm::vec3 normal;
-	glm::vec3 vertex;
-	glm::vec2 text_coord;
-
-	// generate the torus vertices
-	auto currentMainSegmentAngle = 0.0f;
-	for (auto i = 0; i < _mainSegments; i++)
-	{
-		// Calculate sine and cosine of main segment angle
-		auto sinMainSegment = sin(currentMainSegmentAngle);
-		auto cosMainSegment = cos(currentMainSegmentAngle);
-		auto currentTubeSegmentAngle = 0.0f;
-		std::vector<glm::vec3> segment_points;
-		for (auto j = 0; j < _tubeSegments; j++)
+	// use mesh data that PregenerateMeshData() started computing on a
+	// worker thread when it matches, otherwise generate it here
+	MESH_DATA& data = BeginMeshScratch();
+	bool bPregenerated = false;
+	for (int i = 0; i < (int)m_pendingTorusData.size(); i++)
+	{
+		if ((m_pendingTorusData[i].thickness == thickness) &&
+			(m_pendingTorusData[i].mainSegments == mainSegments) &&
+			(m_pendingTorusData[i].tubeSegments == tubeSegments) &&
+			(m_pendingTorusData[i].data.valid() == true))
 		{
-			// Calculate sine and cosine of tube segment angle
-			auto sinTubeSegment = sin(currentTubeSegmentAngle);
-			auto cosTubeSegment = cos(currentTubeSegmentAngle);
-
-			// Calculate vertex position on the surface of torus
-			auto surfacePosition = glm::vec3(
-				(_mainRadius + _tubeRadius * cosTubeSegment) * cosMainSegment,
-				(_mainRadius + _tubeRadius * cosTubeSegment) * sinMainSegment,
-				_tubeRadius * sinTubeSegment);
+			data = m_pendingTorusData[i].data.get();
+			bPregenerated = true;
+			break;
+		}
+	}
+	if (bPregenerated == false)
+	{
+		GenerateTorusMeshData(data, thickness, mainSegments, tubeSegments);
+	}
 
-			//vertex_list.push_back(surfacePosition);
-			segment_points.push_back(surfacePosition);
+	TORUS_CACHE_ENTRY entry;
+	entry.thickness = thickness;
+	entry.mainSegments = mainSegments;
+	entry.tubeSegments = tubeSegments;
+	entry.mesh = GLMesh();
+	m_torusMeshes.push_back(entry);
+	UploadMeshData(m_torusMeshes.back().mesh, data);
 
-			// Update current tube angle
-			currentTubeSegmentAngle += tubeSegmentAngleStep;
-		}
-		segments_list.push_back(segment_points);
-		segment_points.clear();
+	return m_torusMeshes.back().mesh;
+}
 
-		// Update main segment angle
-		currentMainSegmentAngle += mainSegmentAngleStep;
-	}
+///////////////////////////////////////////////////
+//	GenerateSphereMeshData()
+//
+//	Generate the indexed sphere mesh data with the
+//  passed in tessellation density.  Used for the
+//  lower-density level-of-detail variants of the
+//  sphere mesh.  Runs entirely on the CPU so it can
+//  be called from a worker thread.
+///////////////////////////////////////////////////
+void ShapeMeshes::GenerateSphereMeshData(
+	MESH_DATA& data,
+	int segments)
+{
+	int _stacks = segments / 2;
+	glm::vec3 vertex;
 
-	float horizontalStep = 1.0 / _mainSegments;
-	float verticalStep = 1.0 / _tubeSegments;
-	float u = 0.0;
-	float v = 0.0;
+	data.nBottomIndices = 0;
+	data.nTopIndices = 0;
+	data.nSideIndices = 0;
 
-	// connect the various segments together, forming triangles
-	for (int i = 0; i < _mainSegments; i++)
+	// generate the sphere vertex rings from pole to pole - the seam
+	// column is duplicated so the texture coordinates can wrap
+	for (int i = 0; i <= _stacks; i++)
 	{
-		for (int j = 0; j < _tubeSegments; j++)
+		float stackAngle = float(M_PI) * float(i) / float(_stacks);
+		float sinStack = sin(stackAngle);
+		float cosStack = cos(stackAngle);
+		for (int j = 0; j <= segments; j++)
 		{
-			if (((i + 1) < _mainSegments) && ((j + 1) < _tubeSegments))
-			{
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-				vertex_list.push_back(segments_list[i][j + 1]);
-				texture_coords.push_back(glm::vec2(u, v + verticalStep));
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v + verticalStep));
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-				vertex_list.push_back(segments_list[i + 1][j]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v));
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v - verticalStep));
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-			}
-			else
-			{
-				if (((i + 1) == _mainSegments) && ((j + 1) == _tubeSegments))
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][0]);
-					texture_coords.push_back(glm::vec2(u, 0));
-					vertex_list.push_back(segments_list[0][0]);
-					texture_coords.push_back(glm::vec2(0, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[0][j]);
-					texture_coords.push_back(glm::vec2(0, v));
-					vertex_list.push_back(segments_list[0][0]);
-					texture_coords.push_back(glm::vec2(0, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-				else if ((i + 1) == _mainSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][j + 1]);
-					texture_coords.push_back(glm::vec2(u, v + verticalStep));
-					vertex_list.push_back(segments_list[0][j + 1]);
-					texture_coords.push_back(glm::vec2(0, v + verticalStep));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[0][j]);
-					texture_coords.push_back(glm::vec2(0, v));
-					vertex_list.push_back(segments_list[0][j + 1]);
-					texture_coords.push_back(glm::vec2(0, v + verticalStep));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-				else if ((j + 1) == _tubeSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][0]);
-					texture_coords.push_back(glm::vec2(u, 0));
-					vertex_list.push_back(segments_list[i + 1][0]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i + 1][j]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, v));
-					vertex_list.push_back(segments_list[i + 1][0]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-
-			}
-			v += verticalStep;
+			float segmentAngle = glm::radians(360.0f) * float(j % segments) / float(segments);
+
+			// the vertex doubles as the normal on a unit sphere
+			vertex = glm::vec3(
+				sinStack * cos(segmentAngle),
+				cosStack,
+				sinStack * sin(segmentAngle));
+
+			data.vertexData.push_back(vertex.x);
+			data.vertexData.push_back(vertex.y);
+			data.vertexData.push_back(vertex.z);
+			data.vertexData.push_back(vertex.x);
+			data.vertexData.push_back(vertex.y);
+			data.vertexData.push_back(vertex.z);
+			data.vertexData.push_back(float(j) / float(segments));
+			data.vertexData.push_back(float(i) / float(_stacks));
 		}
-		v = 0.0;
-		u += horizontalStep;
 	}
 
-	std::vector<GLfloat> combined_values;
-
-	// combine interleaved vertices, normals, and texture coords
-	for (int i = 0; i < vertex_list.size(); i++)
+	// connect the rings
+	for (int i = 0; i < _stacks; i++)
 	{
-		vertex = vertex_list[i];
-		normal = normalize(vertex);
-
-		text_coord = texture_coords[i];
-		combined_values.push_back(vertex.x);
-		combined_values.push_back(vertex.y);
-		combined_values.push_back(vertex.z);
-		combined_values.push_back(normal.x);
-		combined_values.push_back(normal.y);
-		combined_values.push_back(normal.z);
-		combined_values.push_back(text_coord.x);
-		combined_values.push_back(text_coord.y);
+		for (int j = 0; j < segments; j++)
+		{
+			GLuint current = (GLuint)(i * (segments + 1) + j);
+			GLuint next = current + (GLuint)(segments + 1);
+
+			data.indexData.push_back(current);
+			data.indexData.push_back(next);
+			data.indexData.push_back(current + 1);
+			data.indexData.push_back(current + 1);
+			data.indexData.push_back(next);
+			data.indexData.push_back(next + 1);
+		}
 	}
+}
 
+///////////////////////////////////////////////////
+//	UploadMeshData()
+//
+//	Turn generated mesh data into the vertex array and
+//  buffers of the passed in mesh.  Must run on the
+//  thread that owns the GL context.
+///////////////////////////////////////////////////
+void ShapeMeshes::UploadMeshData(
+	GLMesh& mesh,
+	const MESH_DATA& data)
+{
 	// store vertex and index count
-	m_ExtraTorusMesh2.nVertices = vertex_list.size();
-	m_ExtraTorusMesh2.nIndices = 0;
+	mesh.nVertices = data.vertexData.size() / (g_FloatsPerVertex + g_FloatsPerNormal + g_FloatsPerUV);
+	mesh.nIndices = data.indexData.size();
+	mesh.nBottomIndices = data.nBottomIndices;
+	mesh.nTopIndices = data.nTopIndices;
+	mesh.nSideIndices = data.nSideIndices;
 
 	// Create VAO
-	glGenVertexArrays(1, &m_ExtraTorusMesh2.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(m_ExtraTorusMesh2.vao);
+	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
+	glBindVertexArray(mesh.vao);
 
-	// Create VBOs
-	glGenBuffers(1, m_ExtraTorusMesh2.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, m_ExtraTorusMesh2.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * combined_values.size(), combined_values.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
+	// Create 2 buffers: first one for the vertex data; second one for the indices
+	glGenBuffers(2, mesh.vbos);
+	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
+	UploadVertexData(data.vertexData.data(), mesh.nVertices); // Sends vertex or coordinate data to the GPU
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.vbos[1]); // Activates the buffer
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * data.indexData.size(), data.indexData.data(), GL_STATIC_DRAW);
 
 	if (m_bMemoryLayoutDone == false)
 	{
@@ -2545,25 +1847,441 @@ void ShapeMeshes::LoadExtraTorusMesh2(float thickness)
 	}
 }
 
-//**************************************************************************
-// The following set of methods are called to draw the various basic 3D
-// shapes after they have been loaded in memory.
-//**************************************************************************
-
 ///////////////////////////////////////////////////
-//	DrawBoxMesh()
+//	PregenerateMeshData()
 //
-//	Transform and draw the box mesh to the window.
-// 
+//	Start computing the vertex data of the procedural
+//  shape meshes on worker threads.  The Load*Mesh
+//  methods pick up the finished data and only perform
+//  the GPU upload on the GL thread.
 ///////////////////////////////////////////////////
-void ShapeMeshes::DrawBoxMesh()
+void ShapeMeshes::PregenerateMeshData()
 {
-	glBindVertexArray(m_BoxMesh.vao);
-
-	glDrawElements(GL_TRIANGLES, m_BoxMesh.nIndices, GL_UNSIGNED_INT, (void*)0);
-
-	glBindVertexArray(0);
-}
+	m_pendingConeData = std::async(std::launch::async,
+		[]() { MESH_DATA data; GenerateConicMeshData(data, 1.0f, 0.0f, false); return data; });
+	m_pendingCylinderData = std::async(std::launch::async,
+		[]() { MESH_DATA data; GenerateConicMeshData(data, 1.0f, 1.0f, true); return data; });
+	m_pendingTaperedCylinderData = std::async(std::launch::async,
+		[]() { MESH_DATA data; GenerateConicMeshData(data, 1.0f, 0.5f, true); return data; });
+	m_pendingSphereLOD1Data = std::async(std::launch::async,
+		[]() { MESH_DATA data; GenerateSphereMeshData(data, g_SphereLOD1Segments); return data; });
+	m_pendingSphereLOD2Data = std::async(std::launch::async,
+		[]() { MESH_DATA data; GenerateSphereMeshData(data, g_SphereLOD2Segments); return data; });
+
+	// the torus variants that LoadTorusMesh() will request for the
+	// currently registered tube thickness
+	const int torusSegments[][2] = {
+		{ g_TorusSegments, g_TorusSegments },
+		{ g_TorusLOD1MainSegments, g_TorusLOD1TubeSegments },
+		{ g_TorusLOD2MainSegments, g_TorusLOD2TubeSegments }
+	};
+	float thickness = m_torusThickness;
+	for (int i = 0; i < 3; i++)
+	{
+		PENDING_TORUS_DATA pending;
+		pending.thickness = thickness;
+		pending.mainSegments = torusSegments[i][0];
+		pending.tubeSegments = torusSegments[i][1];
+
+		int mainSegments = torusSegments[i][0];
+		int tubeSegments = torusSegments[i][1];
+		pending.data = std::async(std::launch::async,
+			[thickness, mainSegments, tubeSegments]()
+			{
+				MESH_DATA data;
+				GenerateTorusMeshData(data, thickness, mainSegments, tubeSegments);
+				return data;
+			});
+		m_pendingTorusData.push_back(std::move(pending));
+	}
+}
+
+///////////////////////////////////////////////////
+//	BeginMeshScratch()
+//
+//	Clear and return the shared scratch buffers for
+//  building the next mesh.  The allocations are kept
+//  so repeated loads reuse the same memory.
+///////////////////////////////////////////////////
+ShapeMeshes::MESH_DATA& ShapeMeshes::BeginMeshScratch()
+{
+	m_meshScratch.vertexData.clear();
+	m_meshScratch.indexData.clear();
+	m_meshScratch.nBottomIndices = 0;
+	m_meshScratch.nTopIndices = 0;
+	m_meshScratch.nSideIndices = 0;
+
+	return m_meshScratch;
+}
+
+///////////////////////////////////////////////////
+//	ReleaseScratchBuffers()
+//
+//	Free the scratch buffers used while building mesh
+//  data, along with any leftover pregenerated data.
+///////////////////////////////////////////////////
+void ShapeMeshes::ReleaseScratchBuffers()
+{
+	std::vector<GLfloat>().swap(m_meshScratch.vertexData);
+	std::vector<GLuint>().swap(m_meshScratch.indexData);
+	std::vector<GLubyte>().swap(m_packScratch);
+	m_pendingTorusData.clear();
+}
+
+///////////////////////////////////////////////////
+//	SetPackedVertexFormat()
+//
+//	Enable or disable the packed vertex format.  This
+//  must be called before any of the Load*Mesh methods
+//  since it changes how the vertex data is stored.
+///////////////////////////////////////////////////
+void ShapeMeshes::SetPackedVertexFormat(bool bEnabled)
+{
+	m_bPackedVertexFormat = bEnabled;
+}
+
+///////////////////////////////////////////////////
+//	ConsolidateMeshBuffers()
+//
+//	Copy the data of every loaded mesh into one shared
+//  vertex/index buffer pair with a single vertex array
+//  object.  After consolidation the Draw*Mesh methods
+//  issue ranged draws out of the shared buffers instead
+//  of rebinding a separate VAO for every shape.
+///////////////////////////////////////////////////
+void ShapeMeshes::ConsolidateMeshBuffers()
+{
+	if (m_bConsolidated == true)
+	{
+		return;
+	}
+
+	// all of the shape meshes that may have been loaded, plus any
+	// torus meshes generated so far - tori requested after
+	// consolidation keep their own private buffers
+	std::vector<GLMesh*> meshList = {
+		&m_BoxMesh, &m_ConeMesh, &m_CylinderMesh, &m_PlaneMesh,
+		&m_PrismMesh, &m_Pyramid3Mesh, &m_Pyramid4Mesh, &m_SphereMesh,
+		&m_TaperedCylinderMesh, &m_SphereLOD1Mesh, &m_SphereLOD2Mesh
+	};
+	for (int i = 0; i < (int)m_torusMeshes.size(); i++)
+	{
+		meshList.push_back(&m_torusMeshes[i].mesh);
+	}
+	const int meshCount = (int)meshList.size();
+	const GLsizeiptr vertexStride = GetVertexStride();
+
+	// size the shared buffers for the total loaded mesh data
+	GLsizeiptr totalVertexBytes = 0;
+	GLsizeiptr totalIndexBytes = 0;
+	for (int i = 0; i < meshCount; i++)
+	{
+		if (meshList[i]->vao != 0)
+		{
+			totalVertexBytes += meshList[i]->nVertices * vertexStride;
+			totalIndexBytes += meshList[i]->nIndices * sizeof(GLuint);
+		}
+	}
+	if (totalVertexBytes == 0)
+	{
+		return;
+	}
+
+	glGenBuffers(1, &m_megaVBO);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_megaVBO);
+	glBufferData(GL_COPY_WRITE_BUFFER, totalVertexBytes, NULL, GL_STATIC_DRAW);
+	if (totalIndexBytes > 0)
+	{
+		glGenBuffers(1, &m_megaIBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_megaIBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, totalIndexBytes, NULL, GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+
+	// copy each mesh into the shared buffers on the GPU, record where
+	// it landed, and release its private buffers and vertex array
+	GLsizeiptr vertexByteOffset = 0;
+	GLsizeiptr indexByteOffset = 0;
+	for (int i = 0; i < meshCount; i++)
+	{
+		GLMesh* pMesh = meshList[i];
+		if (pMesh->vao == 0)
+		{
+			continue;
+		}
+
+		GLsizeiptr vertexBytes = pMesh->nVertices * vertexStride;
+		glBindBuffer(GL_COPY_READ_BUFFER, pMesh->vbos[0]);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+			0, vertexByteOffset, vertexBytes);
+		pMesh->baseVertex = (GLint)(vertexByteOffset / vertexStride);
+		vertexByteOffset += vertexBytes;
+
+		if (pMesh->nIndices > 0)
+		{
+			GLsizeiptr indexBytes = pMesh->nIndices * sizeof(GLuint);
+			glBindBuffer(GL_COPY_READ_BUFFER, pMesh->vbos[1]);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_megaIBO);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ELEMENT_ARRAY_BUFFER,
+				0, indexByteOffset, indexBytes);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+			pMesh->indexByteOffset = indexByteOffset;
+			indexByteOffset += indexBytes;
+		}
+
+		glDeleteVertexArrays(1, &pMesh->vao);
+		glDeleteBuffers(2, pMesh->vbos);
+		pMesh->vbos[0] = 0;
+		pMesh->vbos[1] = 0;
+	}
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	// one vertex array describes the shared buffers for all meshes
+	glGenVertexArrays(1, &m_megaVAO);
+	glBindVertexArray(m_megaVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_megaVBO);
+	if (m_megaIBO != 0)
+	{
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_megaIBO);
+	}
+	SetShaderMemoryLayout();
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// keep the vao members valid for any code that binds them directly
+	for (int i = 0; i < meshCount; i++)
+	{
+		if (meshList[i]->nVertices > 0)
+		{
+			meshList[i]->vao = m_megaVAO;
+		}
+	}
+
+	// name the shared objects for external profiler captures
+	LabelGLObject(GL_VERTEX_ARRAY, m_megaVAO, "ShapeMeshes.consolidatedVAO");
+	LabelGLObject(GL_BUFFER, m_megaVBO, "ShapeMeshes.consolidatedVBO");
+	if (m_megaIBO != 0)
+	{
+		LabelGLObject(GL_BUFFER, m_megaIBO, "ShapeMeshes.consolidatedIBO");
+	}
+
+	m_bConsolidated = true;
+	m_bMegaVAOBound = false;
+}
+
+///////////////////////////////////////////////////
+//	GetBoxDrawRanges()
+//
+//	Collect the index range that DrawBoxMesh() would
+//  issue from the consolidated buffers.
+///////////////////////////////////////////////////
+bool ShapeMeshes::GetBoxDrawRanges(
+	std::vector<DRAW_RANGE>& ranges)
+{
+	if ((m_bConsolidated == false) || (m_BoxMesh.vao != m_megaVAO) ||
+		(m_BoxMesh.nIndices == 0))
+	{
+		return false;
+	}
+
+	DRAW_RANGE range;
+	range.indexCount = m_BoxMesh.nIndices;
+	range.firstIndex = (GLuint)(m_BoxMesh.indexByteOffset / sizeof(GLuint));
+	range.baseVertex = m_BoxMesh.baseVertex;
+	ranges.push_back(range);
+
+	return true;
+}
+
+///////////////////////////////////////////////////
+//	GetCylinderDrawRanges()
+//
+//	Collect the index ranges that DrawCylinderMesh()
+//  would issue from the consolidated buffers for the
+//  requested cylinder parts.
+///////////////////////////////////////////////////
+bool ShapeMeshes::GetCylinderDrawRanges(
+	bool bDrawTop,
+	bool bDrawBottom,
+	bool bDrawSides,
+	std::vector<DRAW_RANGE>& ranges)
+{
+	if ((m_bConsolidated == false) || (m_CylinderMesh.vao != m_megaVAO) ||
+		(m_CylinderMesh.nIndices == 0))
+	{
+		return false;
+	}
+
+	GLuint firstIndex = (GLuint)(m_CylinderMesh.indexByteOffset / sizeof(GLuint));
+	DRAW_RANGE range;
+	range.baseVertex = m_CylinderMesh.baseVertex;
+
+	if (bDrawBottom == true)
+	{
+		range.indexCount = m_CylinderMesh.nBottomIndices;
+		range.firstIndex = firstIndex;
+		ranges.push_back(range);
+	}
+	if (bDrawTop == true)
+	{
+		range.indexCount = m_CylinderMesh.nTopIndices;
+		range.firstIndex = firstIndex + m_CylinderMesh.nBottomIndices;
+		ranges.push_back(range);
+	}
+	if (bDrawSides == true)
+	{
+		range.indexCount = m_CylinderMesh.nSideIndices;
+		range.firstIndex = firstIndex + m_CylinderMesh.nBottomIndices + m_CylinderMesh.nTopIndices;
+		ranges.push_back(range);
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////
+//	GetHalfSphereDrawRanges()
+//
+//	Collect the index range that DrawHalfSphereMesh()
+//  would issue from the consolidated buffers.
+///////////////////////////////////////////////////
+bool ShapeMeshes::GetHalfSphereDrawRanges(
+	std::vector<DRAW_RANGE>& ranges)
+{
+	if ((m_bConsolidated == false) || (m_SphereMesh.vao != m_megaVAO) ||
+		(m_SphereMesh.nIndices == 0))
+	{
+		return false;
+	}
+
+	DRAW_RANGE range;
+	range.indexCount = m_SphereMesh.nIndices / 2;
+	range.firstIndex = (GLuint)(m_SphereMesh.indexByteOffset / sizeof(GLuint));
+	range.baseVertex = m_SphereMesh.baseVertex;
+	ranges.push_back(range);
+
+	return true;
+}
+
+///////////////////////////////////////////////////
+//	GetTorusDrawRanges()
+//
+//	Collect the index range that DrawTorusMesh() would
+//  issue from the consolidated buffers - always the
+//  full-density torus mesh.
+///////////////////////////////////////////////////
+bool ShapeMeshes::GetTorusDrawRanges(
+	std::vector<DRAW_RANGE>& ranges)
+{
+	GLMesh& mesh = GetTorusMesh(m_torusThickness, g_TorusSegments, g_TorusSegments);
+
+	if ((m_bConsolidated == false) || (mesh.vao != m_megaVAO) ||
+		(mesh.nIndices == 0))
+	{
+		return false;
+	}
+
+	DRAW_RANGE range;
+	range.indexCount = mesh.nIndices;
+	range.firstIndex = (GLuint)(mesh.indexByteOffset / sizeof(GLuint));
+	range.baseVertex = mesh.baseVertex;
+	ranges.push_back(range);
+
+	return true;
+}
+
+///////////////////////////////////////////////////
+//	BindConsolidatedVAO()
+//
+//	Bind the shared vertex array of the consolidated
+//  buffers for externally issued draws.
+///////////////////////////////////////////////////
+bool ShapeMeshes::BindConsolidatedVAO()
+{
+	if (m_bConsolidated == false)
+	{
+		return false;
+	}
+
+	glBindVertexArray(m_megaVAO);
+	m_bMegaVAOBound = false;
+
+	return true;
+}
+
+///////////////////////////////////////////////////
+//	UnbindConsolidatedVAO()
+//
+//	Unbind the shared vertex array after externally
+//  issued draws.
+///////////////////////////////////////////////////
+void ShapeMeshes::UnbindConsolidatedVAO()
+{
+	glBindVertexArray(0);
+	m_bMegaVAOBound = false;
+}
+
+//**************************************************************************
+// The following set of methods are called to draw the various basic 3D
+// shapes after they have been loaded in memory.
+//**************************************************************************
+
+///////////////////////////////////////////////////
+//	BindMeshVAO()
+//
+//	Bind the vertex array for drawing the passed in
+//  mesh.  In consolidated mode the shared vertex array
+//  stays bound across consecutive draws.
+///////////////////////////////////////////////////
+void ShapeMeshes::BindMeshVAO(const GLMesh& mesh)
+{
+	if ((m_bConsolidated == true) && (mesh.vao == m_megaVAO))
+	{
+		if (m_bMegaVAOBound == false)
+		{
+			glBindVertexArray(m_megaVAO);
+			m_bMegaVAOBound = true;
+		}
+	}
+	else
+	{
+		// meshes generated after consolidation keep their own
+		// vertex array and are bound for each draw
+		glBindVertexArray(mesh.vao);
+		m_bMegaVAOBound = false;
+	}
+}
+
+///////////////////////////////////////////////////
+//	UnbindMeshVAO()
+//
+//	Unbind the vertex array after drawing.  In
+//  consolidated mode this is a no-op so the shared
+//  vertex array carries over to the next draw.
+///////////////////////////////////////////////////
+void ShapeMeshes::UnbindMeshVAO()
+{
+	if (m_bMegaVAOBound == false)
+	{
+		glBindVertexArray(0);
+	}
+}
+
+///////////////////////////////////////////////////
+//	DrawBoxMesh()
+//
+//	Transform and draw the box mesh to the window.
+// 
+///////////////////////////////////////////////////
+void ShapeMeshes::DrawBoxMesh()
+{
+	BindMeshVAO(m_BoxMesh);
+
+	glDrawElementsBaseVertex(GL_TRIANGLES, m_BoxMesh.nIndices, GL_UNSIGNED_INT,
+		(void*)m_BoxMesh.indexByteOffset, m_BoxMesh.baseVertex);
+
+	UnbindMeshVAO();
+}
 
 ///////////////////////////////////////////////////
 //	DrawBoxMeshSide()
@@ -2575,31 +2293,31 @@ void ShapeMeshes::DrawBoxMesh()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawBoxMeshSide(BoxSide side)
 {
-	glBindVertexArray(m_BoxMesh.vao);
+	BindMeshVAO(m_BoxMesh);
 
 	switch (side)
 	{
 	case back:
-		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+		glDrawArrays(GL_TRIANGLE_FAN, m_BoxMesh.baseVertex, 4);
 		break;
 	case bottom:
-		glDrawArrays(GL_TRIANGLE_FAN, 4, 4);
+		glDrawArrays(GL_TRIANGLE_FAN, m_BoxMesh.baseVertex + 4, 4);
 		break;
 	case left:
-		glDrawArrays(GL_TRIANGLE_FAN, 8, 4);
+		glDrawArrays(GL_TRIANGLE_FAN, m_BoxMesh.baseVertex + 8, 4);
 		break;
 	case right:
-		glDrawArrays(GL_TRIANGLE_FAN, 12, 4);
+		glDrawArrays(GL_TRIANGLE_FAN, m_BoxMesh.baseVertex + 12, 4);
 		break;
 	case top:
-		glDrawArrays(GL_TRIANGLE_FAN, 16, 4);
+		glDrawArrays(GL_TRIANGLE_FAN, m_BoxMesh.baseVertex + 16, 4);
 		break;
 	case front:
-		glDrawArrays(GL_TRIANGLE_FAN, 20, 4);
+		glDrawArrays(GL_TRIANGLE_FAN, m_BoxMesh.baseVertex + 20, 4);
 		break;
 	}
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2610,11 +2328,12 @@ void ShapeMeshes::DrawBoxMeshSide(BoxSide side)
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawBoxMeshLines()
 {
-	glBindVertexArray(m_BoxMesh.vao);
+	BindMeshVAO(m_BoxMesh);
 
-	glDrawElements(GL_LINE_LOOP, m_BoxMesh.nIndices, GL_UNSIGNED_INT, (void*)0);
+	glDrawElementsBaseVertex(GL_LINE_LOOP, m_BoxMesh.nIndices, GL_UNSIGNED_INT,
+		(void*)m_BoxMesh.indexByteOffset, m_BoxMesh.baseVertex);
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2626,15 +2345,18 @@ void ShapeMeshes::DrawBoxMeshLines()
 void ShapeMeshes::DrawConeMesh(
 	bool bDrawBottom)
 {
-	glBindVertexArray(m_ConeMesh.vao);
+	BindMeshVAO(m_ConeMesh);
 
 	if (bDrawBottom == true)
 	{
-		glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
+		glDrawElementsBaseVertex(GL_TRIANGLES, m_ConeMesh.nBottomIndices, GL_UNSIGNED_INT,
+			(void*)m_ConeMesh.indexByteOffset, m_ConeMesh.baseVertex);	//bottom
 	}
-	glDrawArrays(GL_TRIANGLE_STRIP, 36, 108);	//sides
+	glDrawElementsBaseVertex(GL_TRIANGLES, m_ConeMesh.nSideIndices, GL_UNSIGNED_INT,
+		(void*)(m_ConeMesh.indexByteOffset + m_ConeMesh.nBottomIndices * sizeof(GLuint)),
+		m_ConeMesh.baseVertex);	//sides
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2646,15 +2368,18 @@ void ShapeMeshes::DrawConeMesh(
 void ShapeMeshes::DrawConeMeshLines(
 	bool bDrawBottom)
 {
-	glBindVertexArray(m_ConeMesh.vao);
+	BindMeshVAO(m_ConeMesh);
 
 	if (bDrawBottom == true)
 	{
-		glDrawArrays(GL_LINES, 0, 36);		//bottom
+		glDrawElementsBaseVertex(GL_LINES, m_ConeMesh.nBottomIndices, GL_UNSIGNED_INT,
+			(void*)m_ConeMesh.indexByteOffset, m_ConeMesh.baseVertex);	//bottom
 	}
-	glDrawArrays(GL_LINE_STRIP, 36, 108);	//sides
+	glDrawElementsBaseVertex(GL_LINES, m_ConeMesh.nSideIndices, GL_UNSIGNED_INT,
+		(void*)(m_ConeMesh.indexByteOffset + m_ConeMesh.nBottomIndices * sizeof(GLuint)),
+		m_ConeMesh.baseVertex);	//sides
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2668,22 +2393,27 @@ void ShapeMeshes::DrawCylinderMesh(
 	bool bDrawBottom,
 	bool bDrawSides)
 {
-	glBindVertexArray(m_CylinderMesh.vao);
+	BindMeshVAO(m_CylinderMesh);
 
 	if (bDrawBottom == true)
 	{
-		glDrawArrays(GL_TRIANGLE_FAN, 0, 36);	//bottom
+		glDrawElementsBaseVertex(GL_TRIANGLES, m_CylinderMesh.nBottomIndices, GL_UNSIGNED_INT,
+			(void*)m_CylinderMesh.indexByteOffset, m_CylinderMesh.baseVertex);	//bottom
 	}
 	if (bDrawTop == true)
 	{
-		glDrawArrays(GL_TRIANGLE_FAN, 36, 36);	//top
+		glDrawElementsBaseVertex(GL_TRIANGLES, m_CylinderMesh.nTopIndices, GL_UNSIGNED_INT,
+			(void*)(m_CylinderMesh.indexByteOffset + m_CylinderMesh.nBottomIndices * sizeof(GLuint)),
+			m_CylinderMesh.baseVertex);	//top
 	}
 	if (bDrawSides == true)
 	{
-		glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
+		glDrawElementsBaseVertex(GL_TRIANGLES, m_CylinderMesh.nSideIndices, GL_UNSIGNED_INT,
+			(void*)(m_CylinderMesh.indexByteOffset + (m_CylinderMesh.nBottomIndices + m_CylinderMesh.nTopIndices) * sizeof(GLuint)),
+			m_CylinderMesh.baseVertex);	//sides
 	}
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2697,22 +2427,27 @@ void ShapeMeshes::DrawCylinderMeshLines(
 	bool bDrawBottom,
 	bool bDrawSides)
 {
-	glBindVertexArray(m_CylinderMesh.vao);
+	BindMeshVAO(m_CylinderMesh);
 
 	if (bDrawBottom == true)
 	{
-		glDrawArrays(GL_LINE_LOOP, 0, 36);	//bottom
+		glDrawElementsBaseVertex(GL_LINES, m_CylinderMesh.nBottomIndices, GL_UNSIGNED_INT,
+			(void*)m_CylinderMesh.indexByteOffset, m_CylinderMesh.baseVertex);	//bottom
 	}
 	if (bDrawTop == true)
 	{
-		glDrawArrays(GL_LINE_LOOP, 36, 36);	//top
+		glDrawElementsBaseVertex(GL_LINES, m_CylinderMesh.nTopIndices, GL_UNSIGNED_INT,
+			(void*)(m_CylinderMesh.indexByteOffset + m_CylinderMesh.nBottomIndices * sizeof(GLuint)),
+			m_CylinderMesh.baseVertex);	//top
 	}
 	if (bDrawSides == true)
 	{
-		glDrawArrays(GL_LINE_STRIP, 72, 146);	//sides
+		glDrawElementsBaseVertex(GL_LINES, m_CylinderMesh.nSideIndices, GL_UNSIGNED_INT,
+			(void*)(m_CylinderMesh.indexByteOffset + (m_CylinderMesh.nBottomIndices + m_CylinderMesh.nTopIndices) * sizeof(GLuint)),
+			m_CylinderMesh.baseVertex);	//sides
 	}
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2723,11 +2458,12 @@ void ShapeMeshes::DrawCylinderMeshLines(
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawPlaneMesh()
 {
-	glBindVertexArray(m_PlaneMesh.vao);
+	BindMeshVAO(m_PlaneMesh);
 
-	glDrawElements(GL_TRIANGLES, m_PlaneMesh.nIndices, GL_UNSIGNED_INT, (void*)0);
+	glDrawElementsBaseVertex(GL_TRIANGLES, m_PlaneMesh.nIndices, GL_UNSIGNED_INT,
+		(void*)m_PlaneMesh.indexByteOffset, m_PlaneMesh.baseVertex);
 	
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2738,11 +2474,12 @@ void ShapeMeshes::DrawPlaneMesh()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawPlaneMeshLines()
 {
-	glBindVertexArray(m_PlaneMesh.vao);
+	BindMeshVAO(m_PlaneMesh);
 
-	glDrawElements(GL_LINE_STRIP, m_PlaneMesh.nIndices, GL_UNSIGNED_INT, (void*)0);
+	glDrawElementsBaseVertex(GL_LINE_STRIP, m_PlaneMesh.nIndices, GL_UNSIGNED_INT,
+		(void*)m_PlaneMesh.indexByteOffset, m_PlaneMesh.baseVertex);
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2753,11 +2490,11 @@ void ShapeMeshes::DrawPlaneMeshLines()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawPrismMesh()
 {
-	glBindVertexArray(m_PrismMesh.vao);
+	BindMeshVAO(m_PrismMesh);
 
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, m_PrismMesh.nVertices);
+	glDrawArrays(GL_TRIANGLE_STRIP, m_PrismMesh.baseVertex, m_PrismMesh.nVertices);
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2768,11 +2505,11 @@ void ShapeMeshes::DrawPrismMesh()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawPrismMeshLines()
 {
-	glBindVertexArray(m_PrismMesh.vao);
+	BindMeshVAO(m_PrismMesh);
 
-	glDrawArrays(GL_LINE_STRIP, 0, m_PrismMesh.nVertices);
+	glDrawArrays(GL_LINE_STRIP, m_PrismMesh.baseVertex, m_PrismMesh.nVertices);
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2783,11 +2520,11 @@ void ShapeMeshes::DrawPrismMeshLines()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawPyramid3Mesh()
 {
-	glBindVertexArray(m_Pyramid3Mesh.vao);
+	BindMeshVAO(m_Pyramid3Mesh);
 
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, m_Pyramid3Mesh.nVertices);
+	glDrawArrays(GL_TRIANGLE_STRIP, m_Pyramid3Mesh.baseVertex, m_Pyramid3Mesh.nVertices);
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2798,11 +2535,11 @@ void ShapeMeshes::DrawPyramid3Mesh()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawPyramid3MeshLines()
 {
-	glBindVertexArray(m_Pyramid3Mesh.vao);
+	BindMeshVAO(m_Pyramid3Mesh);
 
-	glDrawArrays(GL_LINE_STRIP, 0, m_Pyramid3Mesh.nVertices);
+	glDrawArrays(GL_LINE_STRIP, m_Pyramid3Mesh.baseVertex, m_Pyramid3Mesh.nVertices);
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2813,11 +2550,11 @@ void ShapeMeshes::DrawPyramid3MeshLines()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawPyramid4Mesh()
 {
-	glBindVertexArray(m_Pyramid4Mesh.vao);
+	BindMeshVAO(m_Pyramid4Mesh);
 
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, m_Pyramid4Mesh.nVertices);
+	glDrawArrays(GL_TRIANGLE_STRIP, m_Pyramid4Mesh.baseVertex, m_Pyramid4Mesh.nVertices);
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2828,11 +2565,11 @@ void ShapeMeshes::DrawPyramid4Mesh()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawPyramid4MeshLines()
 {
-	glBindVertexArray(m_Pyramid4Mesh.vao);
+	BindMeshVAO(m_Pyramid4Mesh);
 
-	glDrawArrays(GL_LINE_STRIP, 0, m_Pyramid4Mesh.nVertices);
+	glDrawArrays(GL_LINE_STRIP, m_Pyramid4Mesh.baseVertex, m_Pyramid4Mesh.nVertices);
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2843,11 +2580,12 @@ void ShapeMeshes::DrawPyramid4MeshLines()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawSphereMesh()
 {
-	glBindVertexArray(m_SphereMesh.vao);
+	BindMeshVAO(m_SphereMesh);
 
-	glDrawElements(GL_TRIANGLES, m_SphereMesh.nIndices, GL_UNSIGNED_INT, (void*)0);
+	glDrawElementsBaseVertex(GL_TRIANGLES, m_SphereMesh.nIndices, GL_UNSIGNED_INT,
+		(void*)m_SphereMesh.indexByteOffset, m_SphereMesh.baseVertex);
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2858,11 +2596,12 @@ void ShapeMeshes::DrawSphereMesh()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawSphereMeshLines()
 {
-	glBindVertexArray(m_SphereMesh.vao);
+	BindMeshVAO(m_SphereMesh);
 
-	glDrawElements(GL_LINE_STRIP, m_SphereMesh.nIndices, GL_UNSIGNED_INT, (void*)0);
+	glDrawElementsBaseVertex(GL_LINE_STRIP, m_SphereMesh.nIndices, GL_UNSIGNED_INT,
+		(void*)m_SphereMesh.indexByteOffset, m_SphereMesh.baseVertex);
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2873,11 +2612,12 @@ void ShapeMeshes::DrawSphereMeshLines()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawHalfSphereMesh()
 {
-	glBindVertexArray(m_SphereMesh.vao);
+	BindMeshVAO(m_SphereMesh);
 
-	glDrawElements(GL_TRIANGLES, m_SphereMesh.nIndices/2, GL_UNSIGNED_INT, (void*)0);
+	glDrawElementsBaseVertex(GL_TRIANGLES, m_SphereMesh.nIndices/2, GL_UNSIGNED_INT,
+		(void*)m_SphereMesh.indexByteOffset, m_SphereMesh.baseVertex);
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2888,11 +2628,12 @@ void ShapeMeshes::DrawHalfSphereMesh()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawHalfSphereMeshLines()
 {
-	glBindVertexArray(m_SphereMesh.vao);
+	BindMeshVAO(m_SphereMesh);
 
-	glDrawElements(GL_LINE_STRIP, m_SphereMesh.nIndices / 2, GL_UNSIGNED_INT, (void*)0);
+	glDrawElementsBaseVertex(GL_LINE_STRIP, m_SphereMesh.nIndices / 2, GL_UNSIGNED_INT,
+		(void*)m_SphereMesh.indexByteOffset, m_SphereMesh.baseVertex);
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2906,22 +2647,27 @@ void ShapeMeshes::DrawTaperedCylinderMesh(
 	bool bDrawBottom,
 	bool bDrawSides)
 {
-	glBindVertexArray(m_TaperedCylinderMesh.vao);
+	BindMeshVAO(m_TaperedCylinderMesh);
 
 	if (bDrawBottom == true)
 	{
-		glDrawArrays(GL_TRIANGLE_FAN, 0, 36);	//bottom
+		glDrawElementsBaseVertex(GL_TRIANGLES, m_TaperedCylinderMesh.nBottomIndices, GL_UNSIGNED_INT,
+			(void*)m_TaperedCylinderMesh.indexByteOffset, m_TaperedCylinderMesh.baseVertex);	//bottom
 	}
 	if (bDrawTop == true)
 	{
-		glDrawArrays(GL_TRIANGLE_FAN, 36, 72);	//top
+		glDrawElementsBaseVertex(GL_TRIANGLES, m_TaperedCylinderMesh.nTopIndices, GL_UNSIGNED_INT,
+			(void*)(m_TaperedCylinderMesh.indexByteOffset + m_TaperedCylinderMesh.nBottomIndices * sizeof(GLuint)),
+			m_TaperedCylinderMesh.baseVertex);	//top
 	}
 	if (bDrawSides == true)
 	{
-		glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
+		glDrawElementsBaseVertex(GL_TRIANGLES, m_TaperedCylinderMesh.nSideIndices, GL_UNSIGNED_INT,
+			(void*)(m_TaperedCylinderMesh.indexByteOffset + (m_TaperedCylinderMesh.nBottomIndices + m_TaperedCylinderMesh.nTopIndices) * sizeof(GLuint)),
+			m_TaperedCylinderMesh.baseVertex);	//sides
 	}
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2935,22 +2681,27 @@ void ShapeMeshes::DrawTaperedCylinderMeshLines(
 	bool bDrawBottom,
 	bool bDrawSides)
 {
-	glBindVertexArray(m_TaperedCylinderMesh.vao);
+	BindMeshVAO(m_TaperedCylinderMesh);
 
 	if (bDrawBottom == true)
 	{
-		glDrawArrays(GL_LINES, 0, 36);	//bottom
+		glDrawElementsBaseVertex(GL_LINES, m_TaperedCylinderMesh.nBottomIndices, GL_UNSIGNED_INT,
+			(void*)m_TaperedCylinderMesh.indexByteOffset, m_TaperedCylinderMesh.baseVertex);	//bottom
 	}
 	if (bDrawTop == true)
 	{
-		glDrawArrays(GL_LINES, 36, 72);	//top
+		glDrawElementsBaseVertex(GL_LINES, m_TaperedCylinderMesh.nTopIndices, GL_UNSIGNED_INT,
+			(void*)(m_TaperedCylinderMesh.indexByteOffset + m_TaperedCylinderMesh.nBottomIndices * sizeof(GLuint)),
+			m_TaperedCylinderMesh.baseVertex);	//top
 	}
 	if (bDrawSides == true)
 	{
-		glDrawArrays(GL_LINE_STRIP, 72, 146);	//sides
+		glDrawElementsBaseVertex(GL_LINES, m_TaperedCylinderMesh.nSideIndices, GL_UNSIGNED_INT,
+			(void*)(m_TaperedCylinderMesh.indexByteOffset + (m_TaperedCylinderMesh.nBottomIndices + m_TaperedCylinderMesh.nTopIndices) * sizeof(GLuint)),
+			m_TaperedCylinderMesh.baseVertex);	//sides
 	}
 
-	glBindVertexArray(0);
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2961,11 +2712,14 @@ void ShapeMeshes::DrawTaperedCylinderMeshLines(
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawTorusMesh()
 {
-	glBindVertexArray(m_TorusMesh.vao);
+	GLMesh& mesh = GetTorusMesh(m_torusThickness, g_TorusSegments, g_TorusSegments);
 
-	glDrawArrays(GL_TRIANGLES, 0, m_TorusMesh.nVertices);
+	BindMeshVAO(mesh);
 
-	glBindVertexArray(0);
+	glDrawElementsBaseVertex(GL_TRIANGLES, mesh.nIndices, GL_UNSIGNED_INT,
+		(void*)mesh.indexByteOffset, mesh.baseVertex);
+
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2976,11 +2730,14 @@ void ShapeMeshes::DrawTorusMesh()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawTorusMeshLines()
 {
-	glBindVertexArray(m_TorusMesh.vao);
+	GLMesh& mesh = GetTorusMesh(m_torusThickness, g_TorusSegments, g_TorusSegments);
 
-	glDrawArrays(GL_LINE_STRIP, 0, m_TorusMesh.nVertices);
+	BindMeshVAO(mesh);
 
-	glBindVertexArray(0);
+	glDrawElementsBaseVertex(GL_LINES, mesh.nIndices, GL_UNSIGNED_INT,
+		(void*)mesh.indexByteOffset, mesh.baseVertex);
+
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -2991,11 +2748,14 @@ void ShapeMeshes::DrawTorusMeshLines()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawExtraTorusMesh1()
 {
-	glBindVertexArray(m_ExtraTorusMesh1.vao);
+	GLMesh& mesh = GetTorusMesh(m_extraTorus1Thickness, g_TorusSegments, g_TorusSegments);
 
-	glDrawArrays(GL_TRIANGLES, 0, m_ExtraTorusMesh1.nVertices);
+	BindMeshVAO(mesh);
 
-	glBindVertexArray(0);
+	glDrawElementsBaseVertex(GL_TRIANGLES, mesh.nIndices, GL_UNSIGNED_INT,
+		(void*)mesh.indexByteOffset, mesh.baseVertex);
+
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -3006,11 +2766,14 @@ void ShapeMeshes::DrawExtraTorusMesh1()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawExtraTorusMesh2()
 {
-	glBindVertexArray(m_ExtraTorusMesh2.vao);
+	GLMesh& mesh = GetTorusMesh(m_extraTorus2Thickness, g_TorusSegments, g_TorusSegments);
 
-	glDrawArrays(GL_TRIANGLES, 0, m_ExtraTorusMesh2.nVertices);
+	BindMeshVAO(mesh);
 
-	glBindVertexArray(0);
+	glDrawElementsBaseVertex(GL_TRIANGLES, mesh.nIndices, GL_UNSIGNED_INT,
+		(void*)mesh.indexByteOffset, mesh.baseVertex);
+
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -3021,11 +2784,14 @@ void ShapeMeshes::DrawExtraTorusMesh2()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawHalfTorusMesh()
 {
-	glBindVertexArray(m_TorusMesh.vao);
+	GLMesh& mesh = GetTorusMesh(m_torusThickness, g_TorusSegments, g_TorusSegments);
 
-	glDrawArrays(GL_TRIANGLES, 0, m_TorusMesh.nVertices/2);
+	BindMeshVAO(mesh);
 
-	glBindVertexArray(0);
+	glDrawElementsBaseVertex(GL_TRIANGLES, mesh.nIndices / 2, GL_UNSIGNED_INT,
+		(void*)mesh.indexByteOffset, mesh.baseVertex);
+
+	UnbindMeshVAO();
 }
 
 ///////////////////////////////////////////////////
@@ -3036,11 +2802,144 @@ void ShapeMeshes::DrawHalfTorusMesh()
 ///////////////////////////////////////////////////
 void ShapeMeshes::DrawHalfTorusMeshLines()
 {
-	glBindVertexArray(m_TorusMesh.vao);
+	GLMesh& mesh = GetTorusMesh(m_torusThickness, g_TorusSegments, g_TorusSegments);
 
-	glDrawArrays(GL_LINE_STRIP, 0, m_TorusMesh.nVertices / 2);
+	BindMeshVAO(mesh);
 
-	glBindVertexArray(0);
+	glDrawElementsBaseVertex(GL_LINES, mesh.nIndices / 2, GL_UNSIGNED_INT,
+		(void*)mesh.indexByteOffset, mesh.baseVertex);
+
+	UnbindMeshVAO();
+}
+
+///////////////////////////////////////////////////
+//	DrawSphereMeshLOD()
+//
+//	Draw the sphere mesh variant that matches the
+//  passed in distance between the object and the
+//  viewer.
+///////////////////////////////////////////////////
+void ShapeMeshes::DrawSphereMeshLOD(
+	float distanceFromViewer)
+{
+	const GLMesh* pMesh = &m_SphereMesh;
+	if (distanceFromViewer >= g_LOD2Distance)
+	{
+		pMesh = &m_SphereLOD2Mesh;
+	}
+	else if (distanceFromViewer >= g_LOD1Distance)
+	{
+		pMesh = &m_SphereLOD1Mesh;
+	}
+
+	BindMeshVAO(*pMesh);
+
+	glDrawElementsBaseVertex(GL_TRIANGLES, pMesh->nIndices, GL_UNSIGNED_INT,
+		(void*)pMesh->indexByteOffset, pMesh->baseVertex);
+
+	UnbindMeshVAO();
+}
+
+///////////////////////////////////////////////////
+//	DrawTorusMeshLOD()
+//
+//	Draw the torus mesh variant that matches the
+//  passed in distance between the object and the
+//  viewer.
+///////////////////////////////////////////////////
+void ShapeMeshes::DrawTorusMeshLOD(
+	float distanceFromViewer)
+{
+	int mainSegments = g_TorusSegments;
+	int tubeSegments = g_TorusSegments;
+	if (distanceFromViewer >= g_LOD2Distance)
+	{
+		mainSegments = g_TorusLOD2MainSegments;
+		tubeSegments = g_TorusLOD2TubeSegments;
+	}
+	else if (distanceFromViewer >= g_LOD1Distance)
+	{
+		mainSegments = g_TorusLOD1MainSegments;
+		tubeSegments = g_TorusLOD1TubeSegments;
+	}
+	GLMesh& mesh = GetTorusMesh(m_torusThickness, mainSegments, tubeSegments);
+
+	BindMeshVAO(mesh);
+
+	glDrawElementsBaseVertex(GL_TRIANGLES, mesh.nIndices, GL_UNSIGNED_INT,
+		(void*)mesh.indexByteOffset, mesh.baseVertex);
+
+	UnbindMeshVAO();
+}
+
+///////////////////////////////////////////////////
+//	DrawBoxMeshInstanced()
+//
+//	Draw one copy of the box mesh for every passed in
+//  model matrix with a single instanced draw call.
+//
+///////////////////////////////////////////////////
+void ShapeMeshes::DrawBoxMeshInstanced(
+	const std::vector<glm::mat4>& instanceMatrices)
+{
+	if (instanceMatrices.empty())
+	{
+		return;
+	}
+
+	SetInstanceData(m_BoxMesh, instanceMatrices);
+
+	glDrawElementsInstancedBaseVertex(GL_TRIANGLES, m_BoxMesh.nIndices,
+		GL_UNSIGNED_INT, (void*)m_BoxMesh.indexByteOffset,
+		(GLsizei)instanceMatrices.size(), m_BoxMesh.baseVertex);
+
+	ClearInstanceData();
+	UnbindMeshVAO();
+}
+
+///////////////////////////////////////////////////
+//	DrawCylinderMeshInstanced()
+//
+//	Draw one copy of the cylinder mesh for every passed
+//  in model matrix with a single instanced draw call
+//  per cylinder part.
+//
+///////////////////////////////////////////////////
+void ShapeMeshes::DrawCylinderMeshInstanced(
+	const std::vector<glm::mat4>& instanceMatrices,
+	bool bDrawTop,
+	bool bDrawBottom,
+	bool bDrawSides)
+{
+	if (instanceMatrices.empty())
+	{
+		return;
+	}
+
+	SetInstanceData(m_CylinderMesh, instanceMatrices);
+
+	GLsizei instanceCount = (GLsizei)instanceMatrices.size();
+	if (bDrawBottom == true)
+	{
+		glDrawElementsInstancedBaseVertex(GL_TRIANGLES, m_CylinderMesh.nBottomIndices,
+			GL_UNSIGNED_INT, (void*)m_CylinderMesh.indexByteOffset,
+			instanceCount, m_CylinderMesh.baseVertex);	//bottom
+	}
+	if (bDrawTop == true)
+	{
+		glDrawElementsInstancedBaseVertex(GL_TRIANGLES, m_CylinderMesh.nTopIndices,
+			GL_UNSIGNED_INT, (void*)(m_CylinderMesh.indexByteOffset + m_CylinderMesh.nBottomIndices * sizeof(GLuint)),
+			instanceCount, m_CylinderMesh.baseVertex);	//top
+	}
+	if (bDrawSides == true)
+	{
+		glDrawElementsInstancedBaseVertex(GL_TRIANGLES, m_CylinderMesh.nSideIndices,
+			GL_UNSIGNED_INT, (void*)(m_CylinderMesh.indexByteOffset + (m_CylinderMesh.nBottomIndices + m_CylinderMesh.nTopIndices) * sizeof(GLuint)),
+			instanceCount, m_CylinderMesh.baseVertex);	//sides
+	}
+
+	ClearInstanceData();
+	UnbindMeshVAO();
 }
 
 glm::vec3 ShapeMeshes::QuadCrossProduct(
@@ -3088,16 +2987,151 @@ void ShapeMeshes::SetShaderMemoryLayout()
 	// The following code defines the layout of the mesh data in memory - each mesh needs
 	// to have the same memory layout so that the data is retrieved properly by the shaders
 
-	// Strides between vertex coordinates is 6 (x, y, z, r, g, b, a). A tightly packed stride is 0.
-	GLint stride = sizeof(float) * (g_FloatsPerVertex + g_FloatsPerNormal + g_FloatsPerUV);// The number of floats before each
+	if (m_bPackedVertexFormat == true)
+	{
+		GLint stride = g_PackedVertexBytes;
+
+		// Create Vertex Attribute Pointers - the normals and texture
+		// coordinates are normalized/converted back to floats on fetch
+		// so the shaders see the same values as the float layout
+		glVertexAttribPointer(0, g_FloatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
+		glEnableVertexAttribArray(0);
+
+		glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)(sizeof(GLfloat) * g_FloatsPerVertex));
+		glEnableVertexAttribArray(1);
+
+		glVertexAttribPointer(2, g_FloatsPerUV, GL_HALF_FLOAT, GL_FALSE, stride, (void*)(sizeof(GLfloat) * g_FloatsPerVertex + sizeof(GLuint)));
+		glEnableVertexAttribArray(2);
+	}
+	else
+	{
+		// Strides between vertex coordinates is 6 (x, y, z, r, g, b, a). A tightly packed stride is 0.
+		GLint stride = sizeof(float) * (g_FloatsPerVertex + g_FloatsPerNormal + g_FloatsPerUV);// The number of floats before each
 
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, g_FloatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
+		// Create Vertex Attribute Pointers
+		glVertexAttribPointer(0, g_FloatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
+		glEnableVertexAttribArray(0);
 
-	glVertexAttribPointer(1, g_FloatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * g_FloatsPerVertex));
-	glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, g_FloatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * g_FloatsPerVertex));
+		glEnableVertexAttribArray(1);
 
-	glVertexAttribPointer(2, g_FloatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (g_FloatsPerVertex + g_FloatsPerNormal)));
-	glEnableVertexAttribArray(2);
+		glVertexAttribPointer(2, g_FloatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (g_FloatsPerVertex + g_FloatsPerNormal)));
+		glEnableVertexAttribArray(2);
+	}
+
+	// attribute locations 3-6 are reserved for the four columns of the
+	// per-instance model matrix - the pointers for these are set in
+	// SetInstanceData() when an instanced draw method is called
+}
+
+GLsizeiptr ShapeMeshes::GetVertexStride() const
+{
+	if (m_bPackedVertexFormat == true)
+	{
+		return g_PackedVertexBytes;
+	}
+	return sizeof(GLfloat) * (g_FloatsPerVertex + g_FloatsPerNormal + g_FloatsPerUV);
+}
+
+///////////////////////////////////////////////////
+//	UploadVertexData()
+//
+//	Send the passed in interleaved vertex data to the
+//  currently bound vertex buffer.  When the packed
+//  vertex format is active the normals are converted
+//  to GL_INT_2_10_10_10_REV and the texture coords to
+//  half-floats first, cutting the per-vertex footprint
+//  from 32 to 20 bytes.
+///////////////////////////////////////////////////
+void ShapeMeshes::UploadVertexData(
+	const GLfloat* pVertexData,
+	GLuint vertexCount)
+{
+	const GLuint floatsPerVertex = g_FloatsPerVertex + g_FloatsPerNormal + g_FloatsPerUV;
+
+	if (m_bPackedVertexFormat == false)
+	{
+		glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * floatsPerVertex * vertexCount,
+			pVertexData, GL_STATIC_DRAW);
+		return;
+	}
+
+	m_packScratch.resize(g_PackedVertexBytes * vertexCount);
+	GLubyte* pWrite = m_packScratch.data();
+	for (GLuint i = 0; i < vertexCount; i++)
+	{
+		const GLfloat* pVertex = pVertexData + i * floatsPerVertex;
+
+		// the position stays full float
+		memcpy(pWrite, pVertex, sizeof(GLfloat) * g_FloatsPerVertex);
+		pWrite += sizeof(GLfloat) * g_FloatsPerVertex;
+
+		// the normal packs into one signed 2_10_10_10 word
+		GLuint packedNormal =
+			PackNormalComponent(pVertex[3]) |
+			(PackNormalComponent(pVertex[4]) << 10) |
+			(PackNormalComponent(pVertex[5]) << 20);
+		memcpy(pWrite, &packedNormal, sizeof(packedNormal));
+		pWrite += sizeof(packedNormal);
+
+		// the texture coordinates pack into half-floats
+		GLushort packedUVs[2] = { FloatToHalf(pVertex[6]), FloatToHalf(pVertex[7]) };
+		memcpy(pWrite, packedUVs, sizeof(packedUVs));
+		pWrite += sizeof(packedUVs);
+	}
+
+	glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(g_PackedVertexBytes * vertexCount),
+		m_packScratch.data(), GL_STATIC_DRAW);
+}
+
+void ShapeMeshes::SetInstanceData(
+	const GLMesh& mesh,
+	const std::vector<glm::mat4>& instanceMatrices)
+{
+	GLsizeiptr dataSize = sizeof(glm::mat4) * instanceMatrices.size();
+
+	BindMeshVAO(mesh);
+
+	// create the shared instance buffer on first use and grow it
+	// whenever a larger batch of instances is drawn
+	if (0 == m_instanceVBO)
+	{
+		glGenBuffers(1, &m_instanceVBO);
+		LabelGLObject(GL_BUFFER, m_instanceVBO, "ShapeMeshes.instanceVBO");
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+	if (dataSize > m_instanceVBOCapacity)
+	{
+		glBufferData(GL_ARRAY_BUFFER, dataSize, instanceMatrices.data(), GL_DYNAMIC_DRAW);
+		m_instanceVBOCapacity = dataSize;
+	}
+	else
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, instanceMatrices.data());
+	}
+
+	// a vertex attribute can hold at most 4 floats, so the instance
+	// model matrix is passed as four vec4 columns with the attribute
+	// divisor stepping the matrix once per instance
+	for (int column = 0; column < 4; column++)
+	{
+		glVertexAttribPointer(3 + column, 4, GL_FLOAT, GL_FALSE,
+			sizeof(glm::mat4), (void*)(sizeof(glm::vec4) * column));
+		glEnableVertexAttribArray(3 + column);
+		glVertexAttribDivisor(3 + column, 1);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void ShapeMeshes::ClearInstanceData()
+{
+	// disable the matrix attributes and reset their divisors so later
+	// non-instanced draws on the shared vertex array do not source the
+	// stale per-instance matrices
+	for (int column = 0; column < 4; column++)
+	{
+		glVertexAttribDivisor(3 + column, 0);
+		glDisableVertexAttribArray(3 + column);
+	}
 }
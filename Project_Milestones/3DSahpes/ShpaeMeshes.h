@@ -14,6 +14,9 @@
 
 #include <glm/glm.hpp>
 
+#include <future>
+#include <vector>
+
 /***********************************************************
  *  ShapeMeshes
  *
@@ -35,6 +38,27 @@ private:
 		GLuint vbos[2];     // Handles for the vertex buffer objects
 		GLuint nVertices;	// Number of vertices for the mesh
 		GLuint nIndices;    // Number of indices for the mesh
+		// location of the mesh data within the consolidated buffers -
+		// both stay zero until ConsolidateMeshBuffers() has run
+		GLint baseVertex;			// first vertex of the mesh
+		GLsizeiptr indexByteOffset;	// byte offset of the first index
+		// index counts for the separately drawable parts of the round
+		// shapes - all zero for meshes that draw as a single piece
+		GLuint nBottomIndices;
+		GLuint nTopIndices;
+		GLuint nSideIndices;
+	};
+
+	// CPU-side mesh data produced by the Generate*MeshData methods -
+	// built on worker threads by PregenerateMeshData() and turned
+	// into GPU buffers by UploadMeshData() on the GL thread
+	struct MESH_DATA
+	{
+		std::vector<GLfloat> vertexData;
+		std::vector<GLuint> indexData;
+		GLuint nBottomIndices;
+		GLuint nTopIndices;
+		GLuint nSideIndices;
 	};
 
 	// the available 3D shapes
@@ -47,13 +71,75 @@ private:
 	GLMesh m_Pyramid4Mesh;
 	GLMesh m_SphereMesh;
 	GLMesh m_TaperedCylinderMesh;
-	GLMesh m_TorusMesh;
-	// the following torus meshes are provided in case multiple tori of different thicknesses are needed
-	GLMesh m_ExtraTorusMesh1;
-	GLMesh m_ExtraTorusMesh2;
+
+	// lower-density variants of the sphere mesh for drawing distant
+	// objects with less vertex work - loaded along with the
+	// full-density mesh and picked by DrawSphereMeshLOD()
+	GLMesh m_SphereLOD1Mesh;
+	GLMesh m_SphereLOD2Mesh;
+
+	// cache of generated torus meshes keyed by tube thickness and
+	// tessellation - a mesh is generated on the first request for its
+	// key and shared afterwards, so any number of thicknesses is
+	// supported without duplicated buffers
+	struct TORUS_CACHE_ENTRY
+	{
+		float thickness;
+		int mainSegments;
+		int tubeSegments;
+		GLMesh mesh;
+	};
+	std::vector<TORUS_CACHE_ENTRY> m_torusMeshes;
+
+	// tube thicknesses registered by the Load*TorusMesh methods and
+	// drawn by the matching Draw*TorusMesh methods
+	float m_torusThickness;
+	float m_extraTorus1Thickness;
+	float m_extraTorus2Thickness;
+
+	// mesh data being computed ahead of time on worker threads by
+	// PregenerateMeshData() - consumed by the matching Load* methods
+	struct PENDING_TORUS_DATA
+	{
+		float thickness;
+		int mainSegments;
+		int tubeSegments;
+		std::future<MESH_DATA> data;
+	};
+	std::vector<PENDING_TORUS_DATA> m_pendingTorusData;
+	std::future<MESH_DATA> m_pendingConeData;
+	std::future<MESH_DATA> m_pendingCylinderData;
+	std::future<MESH_DATA> m_pendingTaperedCylinderData;
+	std::future<MESH_DATA> m_pendingSphereLOD1Data;
+	std::future<MESH_DATA> m_pendingSphereLOD2Data;
+
+	// scratch buffers reused across mesh builds on the GL thread so
+	// every load does not pay for fresh large allocations - the
+	// worker threads started by PregenerateMeshData() build into
+	// task-local data instead
+	MESH_DATA m_meshScratch;
+	std::vector<GLubyte> m_packScratch;
 
 	bool m_bMemoryLayoutDone;
 
+	// when true the vertex data of every mesh is stored packed -
+	// float positions, GL_INT_2_10_10_10_REV normals, and half-float
+	// texture coordinates - instead of eight full floats per vertex
+	bool m_bPackedVertexFormat;
+
+	// shared buffer holding the per-instance model matrices for the
+	// instanced draw methods - grown on demand and reused across calls
+	GLuint m_instanceVBO;
+	GLsizeiptr m_instanceVBOCapacity;
+
+	// consolidated buffers holding the data of all loaded meshes so
+	// drawing does not need a vertex array switch per shape
+	bool m_bConsolidated;
+	bool m_bMegaVAOBound;
+	GLuint m_megaVAO;
+	GLuint m_megaVBO;
+	GLuint m_megaIBO;
+
 public:
         enum BoxSide
 	{
@@ -81,6 +167,57 @@ public:
 	void LoadExtraTorusMesh1(float thickness = 0.4);
 	void LoadExtraTorusMesh2(float thickness = 0.6);
 
+	// called after all needed shape meshes have been loaded - copies
+	// the data of every loaded mesh into one shared vertex/index
+	// buffer pair with a single vertex array object, so the Draw*Mesh
+	// methods can issue ranged draws without rebinding per shape
+	void ConsolidateMeshBuffers();
+
+	// one index range within the consolidated buffers - used for
+	// building externally submitted indirect draw commands
+	struct DRAW_RANGE
+	{
+		GLuint indexCount;
+		GLuint firstIndex;		// in indices, not bytes
+		GLint baseVertex;
+	};
+
+	// methods for collecting the index ranges that the matching
+	// Draw*Mesh call would issue - they return false when the mesh
+	// cannot be drawn from the consolidated buffers
+	bool GetBoxDrawRanges(
+		std::vector<DRAW_RANGE>& ranges);
+	bool GetCylinderDrawRanges(
+		bool bDrawTop,
+		bool bDrawBottom,
+		bool bDrawSides,
+		std::vector<DRAW_RANGE>& ranges);
+	bool GetHalfSphereDrawRanges(
+		std::vector<DRAW_RANGE>& ranges);
+	bool GetTorusDrawRanges(
+		std::vector<DRAW_RANGE>& ranges);
+
+	// bind/unbind the shared vertex array of the consolidated buffers
+	// for externally issued draws - returns false when the meshes have
+	// not been consolidated
+	bool BindConsolidatedVAO();
+	void UnbindConsolidatedVAO();
+
+	// called before the Load*Mesh methods to start computing the
+	// vertex data of the procedural shapes on worker threads - the
+	// Load*Mesh calls then only perform the GPU upload
+	void PregenerateMeshData();
+
+	// called after scene preparation to release the scratch buffers
+	// used while building mesh data - skip this when meshes will be
+	// re-tessellated at runtime and the scratch should stay warm
+	void ReleaseScratchBuffers();
+
+	// enable/disable storing the mesh vertex data in the packed
+	// vertex format (packed normals and half-float texture coords) -
+	// must be called before any of the shape meshes are loaded
+	void SetPackedVertexFormat(bool bEnabled);
+
 	// methods for drawing the filled shape mesh in the
 	// display window
 	void DrawBoxMesh();
@@ -104,6 +241,25 @@ public:
 	void DrawTorusMesh();
 	void DrawHalfTorusMesh();
 
+	// methods for drawing the sphere/torus mesh variant that matches
+	// the passed in distance between the object and the viewer -
+	// distant objects are drawn with lower-density meshes
+	void DrawSphereMeshLOD(
+		float distanceFromViewer);
+	void DrawTorusMeshLOD(
+		float distanceFromViewer);
+
+	// methods for drawing many copies of a shape mesh with one draw
+	// call - each instance gets its own model matrix through the
+	// instance buffer instead of a separate transform/draw round trip
+	void DrawBoxMeshInstanced(
+		const std::vector<glm::mat4>& instanceMatrices);
+	void DrawCylinderMeshInstanced(
+		const std::vector<glm::mat4>& instanceMatrices,
+		bool bDrawTop = true,
+		bool bDrawBottom = true,
+		bool bDrawSides = true);
+
 	// methods for drawing the shape mesh lines in the
 	// display window
 	void DrawBoxMeshLines();
@@ -140,7 +296,76 @@ private:
 
 	glm::vec3 CalculateTriangleNormal(glm::vec3 p0, glm::vec3 p1, glm::vec3 p2);
 
-	// called to set the memory layout 
+	// called to set the memory layout
 	// template for shader data
 	void SetShaderMemoryLayout();
+
+	// number of bytes per vertex for the active vertex format
+	GLsizeiptr GetVertexStride() const;
+
+	// called to send interleaved float vertex data to the currently
+	// bound vertex buffer, packing it first when the packed vertex
+	// format is active
+	void UploadVertexData(
+		const GLfloat* pVertexData,
+		GLuint vertexCount);
+
+	// called to generate the indexed cylinder/cone/tapered cylinder
+	// mesh data - the ring vertices are shared through the index
+	// buffer instead of being emitted once per triangle.  Static so
+	// it can run on a worker thread without touching GL state.
+	static void GenerateConicMeshData(
+		MESH_DATA& data,
+		float bottomRadius,
+		float topRadius,
+		bool bHasTopCap);
+
+	// called to generate the indexed torus mesh data with the passed
+	// in tube thickness and tessellation density
+	static void GenerateTorusMeshData(
+		MESH_DATA& data,
+		float thickness,
+		int mainSegments,
+		int tubeSegments);
+
+	// called to generate the indexed sphere mesh data with the passed
+	// in tessellation density - used for the lower-density variants
+	static void GenerateSphereMeshData(
+		MESH_DATA& data,
+		int segments);
+
+	// called on the GL thread to turn generated mesh data into the
+	// vertex array and buffers of the passed in mesh
+	void UploadMeshData(
+		GLMesh& mesh,
+		const MESH_DATA& data);
+
+	// called to clear and hand out the shared scratch buffers for
+	// building the next mesh - the allocations are kept so repeated
+	// loads reuse the same memory
+	MESH_DATA& BeginMeshScratch();
+
+	// called to find the cached torus mesh with the passed in
+	// thickness and tessellation, generating it on the first request
+	GLMesh& GetTorusMesh(
+		float thickness,
+		int mainSegments,
+		int tubeSegments);
+
+	// called to bind the per-instance model matrices into the
+	// instance buffer of the passed in mesh before instanced drawing
+	void SetInstanceData(
+		const GLMesh& mesh,
+		const std::vector<glm::mat4>& instanceMatrices);
+
+	// called after an instanced draw to disable the per-instance
+	// matrix attributes again, so later non-instanced draws on the
+	// same vertex array are not corrupted
+	void ClearInstanceData();
+
+	// called to bind/unbind the vertex array for drawing the passed
+	// in mesh - in consolidated mode the shared vertex array is kept
+	// bound across consecutive draws
+	void BindMeshVAO(const GLMesh& mesh);
+	void UnbindMeshVAO();
 };
@@ -0,0 +1,275 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchmarkmain.cpp
+// ============
+// headless benchmark harness - renders the scene offscreen along a scripted
+// camera orbit and prints frame-time percentiles in machine-readable form.
+// This file replaces MainCode.cpp in the benchmark build configuration, so
+// a perf-regression rig can measure the renderer without a visible window
+// or a human at the controls.
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>         // error handling and output
+#include <cstdlib>          // EXIT_FAILURE
+#include <cstdio>           // machine-readable report output
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <GL/glew.h>        // GLEW library
+#include "GLFW/glfw3.h"     // GLFW library
+
+// GLM Math Header inclusions
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "SceneManager.h"
+#include "ViewManager.h"
+#include "ShapeMeshes.h"
+#include "ShaderManager.h"
+#include "FrameProfiler.h"
+
+// Namespace for declaring global variables
+namespace
+{
+	// Macro for window title - the window itself stays hidden
+	const char* const WINDOW_TITLE = "7-1 FinalProject Benchmark";
+
+	// number of frames rendered when none is passed on the command line
+	const int DEFAULT_FRAME_COUNT = 1000;
+
+	// the scripted camera orbits this point at this radius and height
+	const glm::vec3 ORBIT_TARGET = glm::vec3(0.0f, 2.0f, 0.0f);
+	const float ORBIT_RADIUS = 12.0f;
+	const float ORBIT_HEIGHT = 6.0f;
+
+	// Main GLFW window
+	GLFWwindow* g_Window = nullptr;
+
+	// scene manager object for managing the 3D scene prepare and render
+	SceneManager* g_SceneManager = nullptr;
+	// shader manager object for dynamic interaction with the shader code
+	ShaderManager* g_ShaderManager = nullptr;
+	// view manager object for managing the 3D view setup and projection to 2D
+	ViewManager* g_ViewManager = nullptr;
+}
+
+// Function declarations - all functions that are called manually
+// need to be pre-declared at the beginning of the source code.
+bool InitializeGLFW();
+bool InitializeGLEW();
+
+
+/***********************************************************
+ *  main(int, char*)
+ *
+ *  This function gets called after the benchmark has been
+ *  launched.  The only argument is the number of frames to
+ *  render.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	int frameCount = DEFAULT_FRAME_COUNT;
+	if (argc > 1)
+	{
+		frameCount = atoi(argv[1]);
+		if (frameCount <= 0)
+		{
+			frameCount = DEFAULT_FRAME_COUNT;
+		}
+	}
+
+	// if GLFW fails initialization, then terminate the application
+	if (InitializeGLFW() == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// try to create a new shader manager object
+	g_ShaderManager = new ShaderManager();
+	// try to create a new view manager object
+	g_ViewManager = new ViewManager(
+		g_ShaderManager);
+
+	// try to create the main display window
+	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
+
+	// if GLEW fails initialization, then terminate the application
+	if (InitializeGLEW() == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// render as fast as possible - the benchmark must not be paced
+	// by the display refresh
+	glfwSwapInterval(0);
+
+	// the periodic profiler output would pollute the machine-readable
+	// report of the benchmark
+	FrameProfiler::SetEnabled(false);
+
+	// load the shader code from the external GLSL files
+	g_ShaderManager->LoadShaders(
+		"shaders/vertexShader.glsl",
+		"shaders/fragmentShader.glsl");
+	g_ShaderManager->use();
+
+	// try to create a new scene manager object and prepare the 3D scene
+	g_SceneManager = new SceneManager(g_ShaderManager);
+	g_SceneManager->PrepareScene();
+
+	// per-frame render times in milliseconds
+	std::vector<double> frameTimes;
+	frameTimes.reserve(frameCount);
+
+	// render the requested number of frames along the camera orbit
+	for (int frame = 0; frame < frameCount; frame++)
+	{
+		// move the camera along the scripted orbit around the scene
+		float angle = (float)frame * 6.2831853f / (float)frameCount;
+		glm::vec3 cameraPosition = ORBIT_TARGET + glm::vec3(
+			cosf(angle) * ORBIT_RADIUS,
+			ORBIT_HEIGHT,
+			sinf(angle) * ORBIT_RADIUS);
+		g_ViewManager->SetCameraView(cameraPosition, ORBIT_TARGET);
+
+		// the GPU must be idle before the timestamp so each sample
+		// covers the full CPU and GPU cost of its own frame
+		glFinish();
+		std::chrono::steady_clock::time_point frameStart =
+			std::chrono::steady_clock::now();
+
+		// Enable z-depth
+		glEnable(GL_DEPTH_TEST);
+
+		// Clear the frame and z buffers
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// convert from 3D object space to 2D view
+		g_ViewManager->PrepareSceneView();
+
+		// refresh the 3D scene
+		g_SceneManager->RenderScene();
+
+		glFinish();
+		std::chrono::duration<double, std::milli> frameElapsed =
+			std::chrono::steady_clock::now() - frameStart;
+		frameTimes.push_back(frameElapsed.count());
+
+		// Flips the the back buffer with the front buffer every frame.
+		glfwSwapBuffers(g_Window);
+
+		// query the latest GLFW events
+		glfwPollEvents();
+	}
+
+	// report the frame-time percentiles in machine-readable form
+	std::vector<double> sortedTimes = frameTimes;
+	std::sort(sortedTimes.begin(), sortedTimes.end());
+
+	double totalTime = 0.0;
+	for (int i = 0; i < (int)sortedTimes.size(); i++)
+	{
+		totalTime += sortedTimes[i];
+	}
+
+	int sampleCount = (int)sortedTimes.size();
+	int p50Index = (sampleCount * 50) / 100;
+	int p95Index = (sampleCount * 95) / 100;
+	int p99Index = (sampleCount * 99) / 100;
+	if (p95Index >= sampleCount)
+	{
+		p95Index = sampleCount - 1;
+	}
+	if (p99Index >= sampleCount)
+	{
+		p99Index = sampleCount - 1;
+	}
+
+	printf("benchmark_frames=%d\n", sampleCount);
+	printf("benchmark_draw_calls=%d\n", g_SceneManager->GetDrawCallCount());
+	printf("frame_ms_min=%.4f\n", sortedTimes[0]);
+	printf("frame_ms_avg=%.4f\n", totalTime / (double)sampleCount);
+	printf("frame_ms_p50=%.4f\n", sortedTimes[p50Index]);
+	printf("frame_ms_p95=%.4f\n", sortedTimes[p95Index]);
+	printf("frame_ms_p99=%.4f\n", sortedTimes[p99Index]);
+	printf("frame_ms_max=%.4f\n", sortedTimes[sortedTimes.size() - 1]);
+
+	// clear the allocated manager objects from memory
+	if (NULL != g_SceneManager)
+	{
+		delete g_SceneManager;
+		g_SceneManager = NULL;
+	}
+	if (NULL != g_ViewManager)
+	{
+		delete g_ViewManager;
+		g_ViewManager = NULL;
+	}
+	if (NULL != g_ShaderManager)
+	{
+		delete g_ShaderManager;
+		g_ShaderManager = NULL;
+	}
+
+	// Terminates the program successfully
+	exit(EXIT_SUCCESS);
+}
+
+/***********************************************************
+ *	InitializeGLFW()
+ *
+ *  This function is used to initialize the GLFW library.
+ ***********************************************************/
+bool InitializeGLFW()
+{
+	// GLFW: initialize and configure library
+	// --------------------------------------
+	glfwInit();
+
+#ifdef __APPLE__
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#else
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#endif
+
+	// the benchmark renders offscreen - keep the window hidden
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	// GLFW: end -------------------------------
+
+	return(true);
+}
+
+/***********************************************************
+ *	InitializeGLEW()
+ *
+ *  This function is used to initialize the GLEW library.
+ ***********************************************************/
+bool InitializeGLEW()
+{
+	// GLEW: initialize
+	// -----------------------------------------
+	GLenum GLEWInitResult = GLEW_OK;
+
+	// try to initialize the GLEW library
+	GLEWInitResult = glewInit();
+	if (GLEW_OK != GLEWInitResult)
+	{
+		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
+		return false;
+	}
+	// GLEW: end -------------------------------
+
+	return(true);
+}
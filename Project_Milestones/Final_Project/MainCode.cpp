@@ -10,6 +10,10 @@
 #include <iostream>         // error handling and output
 #include <cstdlib>          // EXIT_FAILURE
 
+#include <atomic>           // render thread status flag
+#include <chrono>           // input loop sleep interval
+#include <thread>           // render thread
+
 #include <GL/glew.h>        // GLEW library
 #include "GLFW/glfw3.h"     // GLFW library
 
@@ -22,6 +26,8 @@
 #include "ViewManager.h"
 #include "ShapeMeshes.h"
 #include "ShaderManager.h"
+#include "FrameProfiler.h"
+#include "FramePacer.h"
 
 // Namespace for declaring global variables
 namespace
@@ -38,12 +44,17 @@ namespace
 	ShaderManager* g_ShaderManager = nullptr;
 	// view manager object for managing the 3D view setup and projection to 2D
 	ViewManager* g_ViewManager = nullptr;
+
+	// set by the render thread when it fails to initialize so the
+	// input loop on the main thread knows to shut down
+	std::atomic<bool> g_bRenderThreadFailed(false);
 }
 
 // Function declarations - all functions that are called manually
 // need to be pre-declared at the beginning of the source code.
 bool InitializeGLFW();
 bool InitializeGLEW();
+void RenderThreadMain();
 
 
 /***********************************************************
@@ -69,10 +80,83 @@ int main(int argc, char* argv[])
 	// try to create the main display window
 	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
 
+	// release the GL context from the main thread - the render thread
+	// takes ownership of it, while GLFW requires the event polling to
+	// stay on the main thread
+	glfwMakeContextCurrent(NULL);
+
+	// publish an initial view snapshot so the render thread has a
+	// camera to draw the first frame with
+	g_ViewManager->UpdateSceneView();
+
+	// start the render thread - it initializes GLEW, loads the shaders,
+	// prepares the scene and draws the published snapshots
+	std::thread renderThread(RenderThreadMain);
+
+	// input loop - polls the window events and publishes a fresh view
+	// snapshot for the render thread to pick up
+	while (!glfwWindowShouldClose(g_Window) &&
+		(g_bRenderThreadFailed == false))
+	{
+		// query the latest GLFW events
+		glfwPollEvents();
+
+		// process the input and publish the resulting camera view
+		g_ViewManager->UpdateSceneView();
+
+		// yield briefly - input does not need to run faster than the
+		// display refresh
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	// make sure the render loop sees the close request and wait for
+	// the render thread to release the scene and the GL context
+	glfwSetWindowShouldClose(g_Window, GL_TRUE);
+	renderThread.join();
+
+	// take the GL context back so the remaining GL resources can be
+	// released on this thread
+	glfwMakeContextCurrent(g_Window);
+
+	if (g_bRenderThreadFailed == true)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// clear the allocated manager objects from memory
+	if (NULL != g_ViewManager)
+	{
+		delete g_ViewManager;
+		g_ViewManager = NULL;
+	}
+	if (NULL != g_ShaderManager)
+	{
+		delete g_ShaderManager;
+		g_ShaderManager = NULL;
+	}
+
+	// Terminates the program successfully
+	exit(EXIT_SUCCESS);
+}
+
+/***********************************************************
+ *  RenderThreadMain()
+ *
+ *  This function is the body of the render thread.  It owns
+ *  the GL context for the lifetime of the application and
+ *  draws the view snapshots published by the input loop on
+ *  the main thread.
+ ***********************************************************/
+void RenderThreadMain()
+{
+	// take ownership of the GL context released by the main thread
+	glfwMakeContextCurrent(g_Window);
+
 	// if GLEW fails initialization, then terminate the application
 	if (InitializeGLEW() == false)
 	{
-		return(EXIT_FAILURE);
+		g_bRenderThreadFailed = true;
+		return;
 	}
 
 	// load the shader code from the external GLSL files
@@ -85,50 +169,62 @@ int main(int argc, char* argv[])
 	g_SceneManager = new SceneManager(g_ShaderManager);
 	g_SceneManager->PrepareScene();
 
-	// loop will keep running until the application is closed 
+	// sync the buffer swap to the display refresh, tearing instead of
+	// stuttering on platforms that support late swaps - a frame-rate
+	// cap for thermally limited units would be set up here with
+	// FramePacer::SetFrameRateLimit(30)
+	FramePacer::SetAdaptiveVSync(true);
+
+	// loop will keep running until the application is closed
 	// or until an error has occurred
 	while (!glfwWindowShouldClose(g_Window))
 	{
+		// hold the frame until the paced release time
+		FramePacer::WaitForNextFrame();
+
 		// Enable z-depth
 		glEnable(GL_DEPTH_TEST);
 
+		// redirect the rendering into the scaled offscreen framebuffer
+		g_ViewManager->BeginRender();
+
 		// Clear the frame and z buffers
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-		// convert from 3D object space to 2D view
-		g_ViewManager->PrepareSceneView();
+		// collect the timer query results of the previous frame
+		FrameProfiler::BeginFrame();
+
+		// convert from 3D object space to 2D view using the latest
+		// snapshot the input thread has published
+		FrameProfiler::BeginSection("PrepareSceneView");
+		g_ViewManager->ApplySceneView();
+		FrameProfiler::EndSection();
 
 		// refresh the 3D scene
 		g_SceneManager->RenderScene();
 
+		// upscale the offscreen image to the window
+		g_ViewManager->EndRender();
+
+		// finish the profiled frame before the buffer swap
+		FrameProfiler::EndFrame();
+
 
 		// Flips the the back buffer with the front buffer every frame.
 		glfwSwapBuffers(g_Window);
-
-		// query the latest GLFW events
-		glfwPollEvents();
 	}
 
-	// clear the allocated manager objects from memory
+	// the scene manager owns GL resources, so it is released on the
+	// thread that owns the GL context
 	if (NULL != g_SceneManager)
 	{
 		delete g_SceneManager;
 		g_SceneManager = NULL;
 	}
-	if (NULL != g_ViewManager)
-	{
-		delete g_ViewManager;
-		g_ViewManager = NULL;
-	}
-	if (NULL != g_ShaderManager)
-	{
-		delete g_ShaderManager;
-		g_ShaderManager = NULL;
-	}
 
-	// Terminates the program successfully
-	exit(EXIT_SUCCESS); 
+	// hand the GL context back for the main thread cleanup
+	glfwMakeContextCurrent(NULL);
 }
 
 /***********************************************************
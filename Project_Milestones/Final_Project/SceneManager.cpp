@@ -8,14 +8,139 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "SceneManager.h"
+#include "ViewManager.h"
+#include "FrameProfiler.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+// recycling allocator handed to stb_image in place of malloc/free -
+// decode buffers are sized to the largest texture seen and reused
+// across decodes, so the texture phase does not cycle a fresh
+// multi-megabyte allocation per image
+namespace
+{
+	// each pooled allocation carries its capacity in a small header,
+	// sized to preserve the malloc alignment of the returned pointer
+	const size_t g_DecodeBufferHeaderSize = 16;
+	// allocations below this size take the plain malloc path - only
+	// the image-sized buffers are worth recycling
+	const size_t g_MinPooledBufferSize = 1024 * 1024;
+	// free buffers kept for reuse - enough for every decode worker to
+	// hold one plus some in flight to the upload path
+	const int g_MaxFreeDecodeBuffers = 8;
+
+	std::mutex g_DecodeBufferMutex;
+	std::vector<unsigned char*> g_FreeDecodeBuffers;
+	// largest pooled request seen so far - new pooled buffers are
+	// sized to it so any free buffer can serve any later texture
+	size_t g_LargestDecodeRequest = 0;
+
+	void* DecodeBufferAlloc(size_t byteCount)
+	{
+		unsigned char* pBuffer = NULL;
+		size_t capacity = byteCount;
+
+		std::lock_guard<std::mutex> lock(g_DecodeBufferMutex);
+
+		if (byteCount >= g_MinPooledBufferSize)
+		{
+			if (byteCount > g_LargestDecodeRequest)
+			{
+				g_LargestDecodeRequest = byteCount;
+			}
+
+			// reuse the first free buffer large enough for the request
+			for (int i = 0; i < (int)g_FreeDecodeBuffers.size(); i++)
+			{
+				pBuffer = g_FreeDecodeBuffers[i];
+				if (*(size_t*)pBuffer >= byteCount)
+				{
+					g_FreeDecodeBuffers.erase(g_FreeDecodeBuffers.begin() + i);
+					return (pBuffer + g_DecodeBufferHeaderSize);
+				}
+			}
+
+			// no free buffer fits - grow the new one to the largest
+			// request seen so it can be reused for any later texture
+			capacity = g_LargestDecodeRequest;
+		}
+
+		pBuffer = (unsigned char*)malloc(capacity + g_DecodeBufferHeaderSize);
+		if (NULL == pBuffer)
+		{
+			return NULL;
+		}
+		*(size_t*)pBuffer = capacity;
+		return (pBuffer + g_DecodeBufferHeaderSize);
+	}
+
+	void DecodeBufferFree(void* pPointer)
+	{
+		if (NULL == pPointer)
+		{
+			return;
+		}
+
+		unsigned char* pBuffer = (unsigned char*)pPointer - g_DecodeBufferHeaderSize;
+
+		std::lock_guard<std::mutex> lock(g_DecodeBufferMutex);
+		if ((*(size_t*)pBuffer >= g_MinPooledBufferSize) &&
+			((int)g_FreeDecodeBuffers.size() < g_MaxFreeDecodeBuffers))
+		{
+			g_FreeDecodeBuffers.push_back(pBuffer);
+		}
+		else
+		{
+			free(pBuffer);
+		}
+	}
+
+	void* DecodeBufferRealloc(void* pPointer, size_t oldByteCount, size_t newByteCount)
+	{
+		if (NULL == pPointer)
+		{
+			return DecodeBufferAlloc(newByteCount);
+		}
+
+		// growing within the capacity of the buffer is free
+		unsigned char* pBuffer = (unsigned char*)pPointer - g_DecodeBufferHeaderSize;
+		if (*(size_t*)pBuffer >= newByteCount)
+		{
+			return pPointer;
+		}
+
+		void* pNewPointer = DecodeBufferAlloc(newByteCount);
+		if (NULL != pNewPointer)
+		{
+			memcpy(pNewPointer, pPointer, oldByteCount);
+		}
+		DecodeBufferFree(pPointer);
+		return pNewPointer;
+	}
+}
 
 #ifndef STB_IMAGE_IMPLEMENTATION
+#define STBI_MALLOC(byteCount) DecodeBufferAlloc(byteCount)
+#define STBI_REALLOC_SIZED(pPointer, oldByteCount, newByteCount) DecodeBufferRealloc(pPointer, oldByteCount, newByteCount)
+#define STBI_FREE(pPointer) DecodeBufferFree(pPointer)
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #endif
 
 #include <glm/gtx/transform.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <sys/stat.h>
+
 // declaration of global variables
 namespace
 {
@@ -24,6 +149,338 @@ namespace
 	const char* g_TextureValueName = "objectTexture";
 	const char* g_UseTextureName = "bUseTexture";
 	const char* g_UseLightingName = "bUseLighting";
+
+	// uniform block in the vertex shader that receives the per-object
+	// model matrix from the transform ring buffer - when the block is
+	// not declared in the shader code the classic model uniform is used
+	const char* g_TransformBlockName = "TransformBlock";
+	const GLuint g_TransformBlockBinding = 0;
+	// number of frames the GPU may be working on while the CPU is
+	// already filling the next region of the ring buffer
+	const int g_TransformFramesInFlight = 3;
+	// number of transform slots reserved for each frame
+	const int g_TransformSlotsPerFrame = 128;
+
+	// uniform blocks holding the static scene lighting and the defined
+	// object materials - uploaded once during scene prep so the render
+	// loop only has to send a small material index per object; when the
+	// blocks are not declared in the shader code the classic individually
+	// named uniforms are used instead
+	const char* g_LightingBlockName = "LightingBlock";
+	const GLuint g_LightingBlockBinding = 1;
+	const char* g_MaterialBlockName = "MaterialBlock";
+	const GLuint g_MaterialBlockBinding = 2;
+	const char* g_MaterialIndexName = "materialIndex";
+	// sampler and layer index for the texture array backend - when the
+	// shader does not declare these the classic per-texture 2D sampler
+	// slots are used instead
+	const char* g_TextureArrayName = "objectTextureArray";
+	const char* g_TextureLayerName = "textureLayer";
+	// the material array in the shader block is sized for this many
+	// entries
+	const int g_MaxBlockMaterials = 16;
+
+	// std140 compatible layout for one material entry - the shininess
+	// value rides in the unused w component of the specular color
+	struct MATERIAL_BLOCK_ENTRY
+	{
+		glm::vec4 diffuseColor;
+		glm::vec4 specularColorShininess;
+	};
+
+	// std140 compatible layout for the complete lighting setup - the
+	// bActive flag for each light rides in the w component of the
+	// leading vector and scalar values are packed into vec4s
+	struct POINT_LIGHT_BLOCK_ENTRY
+	{
+		glm::vec4 positionActive;
+		glm::vec4 ambient;
+		glm::vec4 diffuse;
+		glm::vec4 specular;
+		glm::vec4 attenuation;		// constant, linear, quadratic
+	};
+
+	struct LIGHTING_BLOCK_DATA
+	{
+		glm::vec4 ambientLight;
+		glm::vec4 directionalDirectionActive;
+		glm::vec4 directionalAmbient;
+		glm::vec4 directionalDiffuse;
+		glm::vec4 directionalSpecular;
+		glm::vec4 spotPositionActive;
+		glm::vec4 spotDirection;
+		glm::vec4 spotAmbient;
+		glm::vec4 spotDiffuse;
+		glm::vec4 spotSpecular;
+		glm::vec4 spotParams;		// cutOff, outerCutOff, constant, linear
+		glm::vec4 spotParams2;		// quadratic
+		POINT_LIGHT_BLOCK_ENTRY pointLights[4];
+	};
+
+	// uniform block holding the per-draw model matrices for the
+	// indirect submission path, indexed by gl_DrawID in the vertex
+	// shader - only used when the shader declares it
+	const char* g_TransformArrayBlockName = "TransformArrayBlock";
+	const GLuint g_TransformArrayBlockBinding = 3;
+	// flag telling the vertex shader to read its model matrix from the
+	// transform array block instead of the per-draw transform slot
+	const char* g_IndirectDrawFlagName = "bIndirectDraw";
+	// the matrix array in the shader block is sized for this many draws
+	const int g_MaxIndirectDraws = 128;
+
+	// matches the command layout glMultiDrawElementsIndirect reads
+	// from the indirect draw buffer
+	struct DRAW_ELEMENTS_INDIRECT_COMMAND
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLuint baseVertex;
+		GLuint baseInstance;
+	};
+
+	// file extension appended to a texture filename to name its baked
+	// cache file on disk
+	const char* g_TextureCacheExtension = ".texcache";
+
+	// header written at the front of the baked texture cache files -
+	// the pixel data of every mip level follows tightly packed, with
+	// the full-resolution level first
+	struct TEXTURE_CACHE_HEADER
+	{
+		char magic[4];
+		long long sourceModTime;
+		int width;
+		int height;
+		int colorChannels;
+		int levelCount;
+	};
+	const char g_TextureCacheMagic[4] = { 'T', 'X', 'C', '1' };
+
+	// returns the last modification time of the passed in file, or
+	// zero when the file cannot be queried
+	long long GetFileModTime(const std::string& filename)
+	{
+		struct stat fileInfo;
+
+		if (stat(filename.c_str(), &fileInfo) != 0)
+		{
+			return 0;
+		}
+
+		return (long long)fileInfo.st_mtime;
+	}
+
+	// reads the baked mip chain for the passed in texture file into the
+	// pending texture data - returns false when no cache file exists or
+	// the source image has changed since the cache was written
+	bool ReadTextureCache(
+		const std::string& filename,
+		SceneManager::PENDING_TEXTURE& pending)
+	{
+		std::string cacheFilename = filename + g_TextureCacheExtension;
+		TEXTURE_CACHE_HEADER header;
+		size_t totalBytes = 0;
+		int levelWidth = 0;
+		int levelHeight = 0;
+
+		FILE* pCacheFile = fopen(cacheFilename.c_str(), "rb");
+		if (NULL == pCacheFile)
+		{
+			return false;
+		}
+
+		if (fread(&header, sizeof(header), 1, pCacheFile) != 1 ||
+			memcmp(header.magic, g_TextureCacheMagic, sizeof(g_TextureCacheMagic)) != 0 ||
+			header.sourceModTime != GetFileModTime(filename) ||
+			header.levelCount < 1)
+		{
+			fclose(pCacheFile);
+			return false;
+		}
+
+		// the level sizes are derivable from the header, so the whole
+		// mip chain can be pulled in with a single read
+		levelWidth = header.width;
+		levelHeight = header.height;
+		for (int level = 0; level < header.levelCount; level++)
+		{
+			totalBytes += (size_t)levelWidth * levelHeight * header.colorChannels;
+			levelWidth = (levelWidth > 1) ? (levelWidth / 2) : 1;
+			levelHeight = (levelHeight > 1) ? (levelHeight / 2) : 1;
+		}
+
+		pending.cacheData.resize(totalBytes);
+		if (fread(pending.cacheData.data(), 1, totalBytes, pCacheFile) != totalBytes)
+		{
+			fclose(pCacheFile);
+			pending.cacheData.clear();
+			return false;
+		}
+		fclose(pCacheFile);
+
+		pending.width = header.width;
+		pending.height = header.height;
+		pending.colorChannels = header.colorChannels;
+		pending.levelCount = header.levelCount;
+
+		return true;
+	}
+
+	// file the baked scene is loaded from and exported into - a flat
+	// record array next to the executable, so operators can swap scene
+	// layouts without shipping a new binary
+	const char* g_BakedSceneFilename = "scene.baked";
+
+	// header written at the front of the baked scene file - the draw
+	// records follow tightly packed
+	struct BAKED_SCENE_HEADER
+	{
+		char magic[4];
+		int version;
+		int recordCount;
+	};
+	const char g_BakedSceneMagic[4] = { 'B', 'S', 'C', '1' };
+	const int g_BakedSceneVersion = 1;
+
+	// one baked draw record - the fixed int/float layout keeps the file
+	// readable across compilers regardless of how they size the enums
+	// and bools of the in-memory draw item
+	struct BAKED_SCENE_RECORD
+	{
+		int meshID;
+		int boxSide;
+		int bDrawTop;
+		int bDrawBottom;
+		int bDrawSides;
+		float modelMatrix[16];
+		float positionXYZ[3];
+		float boundingRadius;
+		float color[4];
+		float uvScale[2];
+		int bUseTexture;
+		int textureHandle;
+		int materialHandle;
+		int groupID;
+	};
+
+	// pool of worker threads that decode texture images concurrently -
+	// tasks are queued by CreateGLTextureAsync() and their futures
+	// consumed by ProcessPendingTextureUploads() as before
+	const int g_MaxDecodeThreads = 8;
+
+	std::mutex g_DecodeQueueMutex;
+	std::condition_variable g_DecodeQueueSignal;
+	std::deque<std::packaged_task<SceneManager::PENDING_TEXTURE()>> g_DecodeQueue;
+	std::vector<std::thread> g_DecodeThreads;
+	bool g_bDecodePoolShutdown = false;
+
+	// worker loop - drains the task queue and exits once the pool has
+	// shut down and no queued work remains
+	void DecodeWorkerMain()
+	{
+		while (true)
+		{
+			std::packaged_task<SceneManager::PENDING_TEXTURE()> decodeTask;
+			{
+				std::unique_lock<std::mutex> lock(g_DecodeQueueMutex);
+				g_DecodeQueueSignal.wait(lock, []()
+					{
+						return (g_DecodeQueue.empty() == false) ||
+							(g_bDecodePoolShutdown == true);
+					});
+				if (g_DecodeQueue.empty() == true)
+				{
+					return;
+				}
+				decodeTask = std::move(g_DecodeQueue.front());
+				g_DecodeQueue.pop_front();
+			}
+			decodeTask();
+		}
+	}
+
+	// queue a decode task on the pool, starting the worker threads on
+	// first use - one per core up to the pool limit
+	std::future<SceneManager::PENDING_TEXTURE> QueueDecodeTask(
+		std::packaged_task<SceneManager::PENDING_TEXTURE()> decodeTask)
+	{
+		std::future<SceneManager::PENDING_TEXTURE> result = decodeTask.get_future();
+
+		std::unique_lock<std::mutex> lock(g_DecodeQueueMutex);
+		if (g_DecodeThreads.empty() == true)
+		{
+			int threadCount = (int)std::thread::hardware_concurrency();
+			if (threadCount < 1)
+			{
+				threadCount = 1;
+			}
+			if (threadCount > g_MaxDecodeThreads)
+			{
+				threadCount = g_MaxDecodeThreads;
+			}
+			for (int i = 0; i < threadCount; i++)
+			{
+				g_DecodeThreads.push_back(std::thread(DecodeWorkerMain));
+			}
+		}
+		g_DecodeQueue.push_back(std::move(decodeTask));
+		lock.unlock();
+		g_DecodeQueueSignal.notify_one();
+
+		return result;
+	}
+
+	// finish the queued decodes, join the worker threads, and release
+	// the recycled decode buffers
+	void ShutdownDecodePool()
+	{
+		{
+			std::unique_lock<std::mutex> lock(g_DecodeQueueMutex);
+			g_bDecodePoolShutdown = true;
+		}
+		g_DecodeQueueSignal.notify_all();
+		for (int i = 0; i < (int)g_DecodeThreads.size(); i++)
+		{
+			g_DecodeThreads[i].join();
+		}
+		g_DecodeThreads.clear();
+		g_bDecodePoolShutdown = false;
+
+		std::lock_guard<std::mutex> bufferLock(g_DecodeBufferMutex);
+		for (int i = 0; i < (int)g_FreeDecodeBuffers.size(); i++)
+		{
+			free(g_FreeDecodeBuffers[i]);
+		}
+		g_FreeDecodeBuffers.clear();
+	}
+
+	// attach a debug label to a GL object so external capture tools
+	// show names instead of raw object numbers
+	void LabelGLObject(GLenum identifier, GLuint objectID, const std::string& label)
+	{
+		if (GLEW_KHR_debug)
+		{
+			glObjectLabel(identifier, objectID, -1, label.c_str());
+		}
+	}
+
+	// bracket a region of GL calls with a named debug group so frame
+	// captures show where each scene stage begins and ends
+	void PushDebugGroup(const char* groupName)
+	{
+		if (GLEW_KHR_debug)
+		{
+			glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, groupName);
+		}
+	}
+	void PopDebugGroup()
+	{
+		if (GLEW_KHR_debug)
+		{
+			glPopDebugGroup();
+		}
+	}
 }
 
 /***********************************************************
@@ -35,6 +492,108 @@ SceneManager::SceneManager(ShaderManager* pShaderManager)
 {
 	m_pShaderManager = pShaderManager;
 	m_basicMeshes = new ShapeMeshes();
+
+	// resolve the uniform handles for the per-object shader values
+	// once so the render loop does not need to look them up by name
+	if (NULL != m_pShaderManager)
+	{
+		m_hModelMatrix = m_pShaderManager->GetUniformHandle(g_ModelName);
+		m_hColorValue = m_pShaderManager->GetUniformHandle(g_ColorValueName);
+		m_hUseTexture = m_pShaderManager->GetUniformHandle(g_UseTextureName);
+		m_hTextureValue = m_pShaderManager->GetUniformHandle(g_TextureValueName);
+		m_hUVscale = m_pShaderManager->GetUniformHandle("UVscale");
+		m_hMaterialDiffuseColor = m_pShaderManager->GetUniformHandle("material.diffuseColor");
+		m_hMaterialSpecularColor = m_pShaderManager->GetUniformHandle("material.specularColor");
+		m_hMaterialShininess = m_pShaderManager->GetUniformHandle("material.shininess");
+		m_hMaterialIndex = m_pShaderManager->GetUniformHandle(g_MaterialIndexName);
+		m_hTextureArray = m_pShaderManager->GetUniformHandle(g_TextureArrayName);
+		m_hTextureLayer = m_pShaderManager->GetUniformHandle(g_TextureLayerName);
+		m_hIndirectDrawFlag = m_pShaderManager->GetUniformHandle(g_IndirectDrawFlagName);
+	}
+
+	// the texture array backend needs the array sampler and the layer
+	// index declared in the shader code
+	m_bUseTextureArrays =
+		(NULL != m_pShaderManager) &&
+		(m_hTextureArray >= 0) && (m_hTextureLayer >= 0);
+	m_bTextureArraysBuilt = false;
+
+	// no textures are registered until LoadSceneTextures() runs
+	m_loadedTextures = 0;
+	m_texturePBO = 0;
+
+	// the lighting and material uniform blocks are uploaded later
+	// during PrepareScene()
+	// the texture and material handles are resolved at registration
+	// time in LoadSceneTextures() and DefineObjectMaterials()
+	m_mugBaseTextureHandle = -1;
+	m_flagTextureHandle = -1;
+	m_tableTextureHandle = -1;
+	m_plankTextureHandle = -1;
+	m_plasticTextureHandle = -1;
+	m_officeTextureHandle = -1;
+	m_woodMaterialHandle = -1;
+	m_plasticMaterialHandle = -1;
+
+	// sentinel values force the first update of each shader parameter
+	// through the redundant-state filtering
+	m_lastColor = glm::vec4(-1.0f);
+	m_lastUVScale = glm::vec2(-1.0f);
+	m_lastUseTexture = -1;
+	m_lastTextureSlot = -2;
+	m_lastTextureLayer = -2;
+	m_lastMaterialHandle = -2;
+
+	// the instrumentation counters reset at the start of every frame
+	m_frameDrawCalls = 0;
+	m_frameStateChanges = 0;
+	m_frameUniformUpdates = 0;
+
+	// the draw list is recorded during the first RenderScene() call
+	m_bRecordingDraws = false;
+	m_bDrawListRecorded = false;
+	m_currentDrawItem.meshID = drawBox;
+	m_currentDrawItem.boxSide = ShapeMeshes::front;
+	m_currentDrawItem.bDrawTop = true;
+	m_currentDrawItem.bDrawBottom = true;
+	m_currentDrawItem.bDrawSides = true;
+	m_currentDrawItem.modelMatrix = glm::mat4(1.0f);
+	m_currentDrawItem.positionXYZ = glm::vec3(0.0f);
+	m_currentDrawItem.boundingRadius = 0.0f;
+	m_currentDrawItem.color = glm::vec4(1.0f);
+	m_currentDrawItem.uvScale = glm::vec2(1.0f);
+	m_currentDrawItem.bUseTexture = false;
+	m_currentDrawItem.textureHandle = -1;
+	m_currentDrawItem.materialHandle = -1;
+	m_currentDrawItem.groupID = -1;
+	m_occlusionFrameParity = 0;
+	// the indirect submission path is enabled by BuildIndirectBuckets()
+	// when the hardware and the shader support it
+	m_bUseIndirectDraw = false;
+	m_indirectBuffer = 0;
+	m_indirectMatrixUBO = 0;
+	// front-to-back replay is on by default; the depth pre-pass only
+	// pays off when the fragment work clearly dominates, so it is off
+	m_bSortFrontToBack = true;
+	m_bDepthPrePass = false;
+
+	m_bUseLightingBuffer = false;
+	m_bUseMaterialBuffer = false;
+	m_lightingUBO = 0;
+	m_materialUBO = 0;
+
+	// the transform ring buffer is created later in PrepareScene()
+	m_bUseTransformBuffer = false;
+	m_transformUBO = 0;
+	m_pTransformBufferData = NULL;
+	m_transformSlotSize = 0;
+	m_transformSlotsPerFrame = g_TransformSlotsPerFrame;
+	m_transformFrameIndex = 0;
+	m_transformSlotIndex = 0;
+	for (int i = 0; i < g_TransformFramesInFlight; i++)
+	{
+		m_transformFrameSync[i] = NULL;
+	}
 }
 
 /***********************************************************
@@ -44,11 +603,313 @@ SceneManager::SceneManager(ShaderManager* pShaderManager)
  ***********************************************************/
 SceneManager::~SceneManager()
 {
+	// finish any queued texture decodes and stop the worker pool -
+	// every pending future is ready afterwards
+	ShutdownDecodePool();
+
+	// release the image data of decodes that never got uploaded
+	for (int i = 0; i < (int)m_pendingTextures.size(); i++)
+	{
+		PENDING_TEXTURE pending = m_pendingTextures[i].get();
+		if (NULL != pending.pImageData)
+		{
+			stbi_image_free(pending.pImageData);
+		}
+	}
+	m_pendingTextures.clear();
+	for (int i = 0; i < (int)m_decodedTextures.size(); i++)
+	{
+		if (NULL != m_decodedTextures[i].pImageData)
+		{
+			stbi_image_free(m_decodedTextures[i].pImageData);
+		}
+	}
+	m_decodedTextures.clear();
+	if (m_texturePBO != 0)
+	{
+		glDeleteBuffers(1, &m_texturePBO);
+		m_texturePBO = 0;
+	}
+
+	// free the occlusion query objects of the draw groups
+	for (int i = 0; i < (int)m_drawGroups.size(); i++)
+	{
+		glDeleteQueries(2, m_drawGroups[i].occlusionQuery);
+	}
+	m_drawGroups.clear();
+
+	// free the baked indirect command and matrix buffers
+	if (m_indirectBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_indirectBuffer);
+		m_indirectBuffer = 0;
+	}
+	if (m_indirectMatrixUBO != 0)
+	{
+		glDeleteBuffers(1, &m_indirectMatrixUBO);
+		m_indirectMatrixUBO = 0;
+	}
+
+	DestroyTransformBuffer();
+	DestroyLightingBuffers();
+
 	m_pShaderManager = NULL;
 	delete m_basicMeshes;
 	m_basicMeshes = NULL;
 }
 
+/***********************************************************
+ *  InitializeMaterialBuffer()
+ *
+ *  This method packs the defined object materials into a
+ *  uniform block and uploads them once, so the render loop
+ *  only has to set a small material index per object.
+ ***********************************************************/
+void SceneManager::InitializeMaterialBuffer()
+{
+	// if the shader does not declare the material uniform block then
+	// keep sending the material values through the named uniforms
+	GLuint blockIndex = glGetUniformBlockIndex(
+		m_pShaderManager->m_programID, g_MaterialBlockName);
+	if (GL_INVALID_INDEX == blockIndex)
+	{
+		std::cout << "Material block not found in shader, using per-object material uniforms" << std::endl;
+		m_bUseMaterialBuffer = false;
+		return;
+	}
+
+	glUniformBlockBinding(
+		m_pShaderManager->m_programID, blockIndex, g_MaterialBlockBinding);
+
+	MATERIAL_BLOCK_ENTRY materialData[g_MaxBlockMaterials] = {};
+	int materialCount = (int)m_objectMaterials.size();
+	if (materialCount > g_MaxBlockMaterials)
+	{
+		std::cout << "Too many materials for the material block, extra entries ignored" << std::endl;
+		materialCount = g_MaxBlockMaterials;
+	}
+	for (int i = 0; i < materialCount; i++)
+	{
+		materialData[i].diffuseColor = glm::vec4(m_objectMaterials[i].diffuseColor, 0.0f);
+		materialData[i].specularColorShininess = glm::vec4(
+			m_objectMaterials[i].specularColor, m_objectMaterials[i].shininess);
+	}
+
+	glGenBuffers(1, &m_materialUBO);
+	glBindBuffer(GL_UNIFORM_BUFFER, m_materialUBO);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(materialData), materialData, GL_STATIC_DRAW);
+	glBindBufferBase(GL_UNIFORM_BUFFER, g_MaterialBlockBinding, m_materialUBO);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	m_bUseMaterialBuffer = true;
+}
+
+/***********************************************************
+ *  DestroyLightingBuffers()
+ *
+ *  This method frees the lighting and material uniform
+ *  block buffers.
+ ***********************************************************/
+void SceneManager::DestroyLightingBuffers()
+{
+	if (0 != m_lightingUBO)
+	{
+		glDeleteBuffers(1, &m_lightingUBO);
+		m_lightingUBO = 0;
+	}
+	if (0 != m_materialUBO)
+	{
+		glDeleteBuffers(1, &m_materialUBO);
+		m_materialUBO = 0;
+	}
+	m_bUseLightingBuffer = false;
+	m_bUseMaterialBuffer = false;
+}
+
+/***********************************************************
+ *  InitializeTransformBuffer()
+ *
+ *  This method creates the persistently mapped ring buffer
+ *  that holds the per-object model matrices.  The buffer is
+ *  mapped once and stays mapped so the render loop can fill
+ *  it with plain memory writes instead of individual
+ *  glUniformMatrix4fv calls.
+ ***********************************************************/
+void SceneManager::InitializeTransformBuffer()
+{
+	// persistent mapping needs immutable buffer storage, which older
+	// contexts (the 3.3 Apple path) do not expose
+	if (!GLEW_ARB_buffer_storage && !GLEW_VERSION_4_4)
+	{
+		std::cout << "Buffer storage not supported, using per-object model uniform" << std::endl;
+		m_bUseTransformBuffer = false;
+		return;
+	}
+
+	// if the shader does not declare the transform uniform block then
+	// keep sending the model matrix through the classic model uniform
+	GLuint blockIndex = glGetUniformBlockIndex(
+		m_pShaderManager->m_programID, g_TransformBlockName);
+	if (GL_INVALID_INDEX == blockIndex)
+	{
+		std::cout << "Transform block not found in shader, using per-object model uniform" << std::endl;
+		m_bUseTransformBuffer = false;
+		return;
+	}
+
+	glUniformBlockBinding(
+		m_pShaderManager->m_programID, blockIndex, g_TransformBlockBinding);
+
+	// each transform slot needs to start on a valid uniform buffer
+	// offset boundary for glBindBufferRange
+	GLint uniformAlignment = 256;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+	m_transformSlotSize = sizeof(glm::mat4);
+	if ((m_transformSlotSize % uniformAlignment) != 0)
+	{
+		m_transformSlotSize += uniformAlignment - (m_transformSlotSize % uniformAlignment);
+	}
+
+	// allocate one region per in-flight frame and map the whole
+	// buffer persistently - the coherent flag makes the CPU writes
+	// visible to the GPU without explicit flushes
+	GLsizeiptr bufferSize =
+		(GLsizeiptr)m_transformSlotSize * m_transformSlotsPerFrame * g_TransformFramesInFlight;
+
+	glGenBuffers(1, &m_transformUBO);
+	LabelGLObject(GL_BUFFER, m_transformUBO, "SceneManager.transformRingBuffer");
+	glBindBuffer(GL_UNIFORM_BUFFER, m_transformUBO);
+	glBufferStorage(GL_UNIFORM_BUFFER, bufferSize, NULL,
+		GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+	m_pTransformBufferData = (GLubyte*)glMapBufferRange(
+		GL_UNIFORM_BUFFER, 0, bufferSize,
+		GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	if (NULL == m_pTransformBufferData)
+	{
+		std::cout << "Could not map the transform ring buffer, using per-object model uniform" << std::endl;
+		glDeleteBuffers(1, &m_transformUBO);
+		m_transformUBO = 0;
+		m_bUseTransformBuffer = false;
+		return;
+	}
+
+	m_bUseTransformBuffer = true;
+}
+
+/***********************************************************
+ *  DestroyTransformBuffer()
+ *
+ *  This method unmaps and frees the transform ring buffer.
+ ***********************************************************/
+void SceneManager::DestroyTransformBuffer()
+{
+	for (int i = 0; i < g_TransformFramesInFlight; i++)
+	{
+		if (NULL != m_transformFrameSync[i])
+		{
+			glDeleteSync(m_transformFrameSync[i]);
+			m_transformFrameSync[i] = NULL;
+		}
+	}
+
+	if (0 != m_transformUBO)
+	{
+		glBindBuffer(GL_UNIFORM_BUFFER, m_transformUBO);
+		glUnmapBuffer(GL_UNIFORM_BUFFER);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		glDeleteBuffers(1, &m_transformUBO);
+		m_transformUBO = 0;
+	}
+
+	m_pTransformBufferData = NULL;
+	m_bUseTransformBuffer = false;
+}
+
+/***********************************************************
+ *  BeginTransformFrame()
+ *
+ *  This method advances the ring buffer to the region that
+ *  belongs to the next frame and waits on the fence for that
+ *  region in case the GPU is still reading from it.
+ ***********************************************************/
+void SceneManager::BeginTransformFrame()
+{
+	if (m_bUseTransformBuffer == false)
+	{
+		return;
+	}
+
+	m_transformFrameIndex = (m_transformFrameIndex + 1) % g_TransformFramesInFlight;
+	m_transformSlotIndex = 0;
+
+	if (NULL != m_transformFrameSync[m_transformFrameIndex])
+	{
+		// the GPU is normally several frames ahead of this fence, so
+		// in practice this wait returns immediately
+		glClientWaitSync(m_transformFrameSync[m_transformFrameIndex],
+			GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+		glDeleteSync(m_transformFrameSync[m_transformFrameIndex]);
+		m_transformFrameSync[m_transformFrameIndex] = NULL;
+	}
+}
+
+/***********************************************************
+ *  EndTransformFrame()
+ *
+ *  This method places a fence after the draw commands for
+ *  the current frame so the region of the ring buffer is not
+ *  overwritten before the GPU has consumed it.
+ ***********************************************************/
+void SceneManager::EndTransformFrame()
+{
+	if (m_bUseTransformBuffer == false)
+	{
+		return;
+	}
+
+	m_transformFrameSync[m_transformFrameIndex] =
+		glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/***********************************************************
+ *  ApplyTextureFilter()
+ *
+ *  This method sets the filtering parameters of the
+ *  currently bound texture for the passed in quality level.
+ *  Trilinear and anisotropic filtering sample across the
+ *  generated mip chain, so minified texel fetches hit the
+ *  lower-resolution levels instead of always reading the
+ *  full-resolution image.
+ ***********************************************************/
+void SceneManager::ApplyTextureFilter(GLenum target, TextureFilterQuality filterQuality)
+{
+	glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	if (filterQuality == filterBilinear)
+	{
+		// original behavior - only the full-resolution level is sampled
+		glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		return;
+	}
+
+	// blend between the two closest mip levels when minifying
+	glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+
+	if (filterQuality == filterAnisotropic)
+	{
+		// anisotropic filtering is an extension, so fall back to plain
+		// trilinear filtering when the driver does not support it
+		if (GLEW_EXT_texture_filter_anisotropic)
+		{
+			GLfloat maxAnisotropy = 1.0f;
+			glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
+			glTexParameterf(target, GL_TEXTURE_MAX_ANISOTROPY_EXT, maxAnisotropy);
+		}
+	}
+}
+
 /***********************************************************
  *  CreateGLTexture()
  *
@@ -57,7 +918,8 @@ SceneManager::~SceneManager()
  *  generating the mipmaps, and loading the read texture into
  *  the next available texture slot in memory.
  ***********************************************************/
-bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
+int SceneManager::CreateGLTexture(const char* filename, std::string tag,
+	TextureFilterQuality filterQuality)
 {
 	int width = 0;
 	int height = 0;
@@ -87,8 +949,7 @@ bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 		// set texture filtering parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		ApplyTextureFilter(GL_TEXTURE_2D, filterQuality);
 
 		// if the loaded image is in RGB format
 		if (colorChannels == 3)
@@ -99,7 +960,7 @@ bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
 		else
 		{
 			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
-			return false;
+			return -1;
 		}
 
 		// generate the texture mipmaps for mapping textures to lower resolutions
@@ -110,254 +971,1562 @@ bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
 		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
 
 		// register the loaded texture and associate it with the special tag string
-		m_textureIDs[m_loadedTextures].ID = textureID;
-		m_textureIDs[m_loadedTextures].tag = tag;
-		m_loadedTextures++;
-
-		return true;
+		LabelGLObject(GL_TEXTURE, textureID, "Texture." + tag);
+		TEXTURE_INFO textureInfo;
+		textureInfo.ID = textureID;
+		textureInfo.tag = tag;
+		m_textureIDs.push_back(textureInfo);
+		m_loadedTextures = (int)m_textureIDs.size();
+
+		return (m_loadedTextures - 1);
 	}
 
 	std::cout << "Could not load image:" << filename << std::endl;
 
 	// Error loading the image
-	return false;
+	return -1;
 }
 
 /***********************************************************
- *  BindGLTextures()
+ *  CreateGLTextureAsync()
  *
- *  This method is used for binding the loaded textures to
- *  OpenGL texture memory slots.  There are up to 16 slots.
+ *  This method registers a 1x1 placeholder texture for the
+ *  passed in tag and starts decoding the image file on a
+ *  worker thread.  ProcessPendingTextureUploads() swaps the
+ *  real image in once the decode has finished, so the scene
+ *  can start rendering before all textures are loaded.
  ***********************************************************/
-void SceneManager::BindGLTextures()
+int SceneManager::CreateGLTextureAsync(const char* filename, std::string tag,
+	TextureFilterQuality filterQuality)
 {
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		// bind textures on corresponding texture units
-		glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
-	}
+	GLuint textureID = 0;
+	// neutral gray pixel shown until the real image arrives
+	GLubyte placeholderPixel[4] = { 128, 128, 128, 255 };
+
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters - the filter state stays on the
+	// texture object when the real image is swapped in later
+	ApplyTextureFilter(GL_TEXTURE_2D, filterQuality);
+
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholderPixel);
+	glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+
+	// register the placeholder texture and associate it with the special tag string
+	LabelGLObject(GL_TEXTURE, textureID, "Texture." + tag);
+	int slot = m_loadedTextures;
+	TEXTURE_INFO textureInfo;
+	textureInfo.ID = textureID;
+	textureInfo.tag = tag;
+	m_textureIDs.push_back(textureInfo);
+	m_loadedTextures = (int)m_textureIDs.size();
+
+	// decode the image file on the worker pool - the upload happens
+	// later on the GL thread when the decode is done
+	std::string file = filename;
+	std::packaged_task<PENDING_TEXTURE()> decodeTask(
+		[file, slot]()
+		{
+			PENDING_TEXTURE pending;
+			pending.filename = file;
+			pending.slot = slot;
+			pending.width = 0;
+			pending.height = 0;
+			pending.colorChannels = 0;
+			pending.levelCount = 1;
+			pending.pImageData = NULL;
+			pending.bFromCache = false;
+
+			// when a baked cache from a previous run is still current
+			// the full mip chain is read with no decode work at all
+			if (ReadTextureCache(file, pending) == true)
+			{
+				pending.bFromCache = true;
+				return pending;
+			}
+
+			// indicate to always flip images vertically when loaded
+			stbi_set_flip_vertically_on_load(true);
+
+			pending.pImageData = stbi_load(
+				file.c_str(),
+				&pending.width,
+				&pending.height,
+				&pending.colorChannels,
+				0);
+
+			return pending;
+		});
+	m_pendingTextures.push_back(QueueDecodeTask(std::move(decodeTask)));
+
+	return slot;
 }
 
 /***********************************************************
- *  DestroyGLTextures()
+ *  ProcessPendingTextureUploads()
  *
- *  This method is used for freeing the memory in all the
- *  used texture memory slots.
+ *  This method uploads any texture decodes that have been
+ *  finished by the worker threads.  The pixels are streamed
+ *  through a pixel buffer object into the placeholder
+ *  texture that was registered for the tag, so the texture
+ *  units and slot numbers stay valid.
  ***********************************************************/
-void SceneManager::DestroyGLTextures()
+void SceneManager::ProcessPendingTextureUploads()
 {
-	for (int i = 0; i < m_loadedTextures; i++)
+	for (int i = (int)m_pendingTextures.size() - 1; i >= 0; i--)
+	{
+		if (m_pendingTextures[i].wait_for(std::chrono::seconds(0)) !=
+			std::future_status::ready)
+		{
+			continue;
+		}
+
+		PENDING_TEXTURE pending = m_pendingTextures[i].get();
+		m_pendingTextures.erase(m_pendingTextures.begin() + i);
+
+		if ((pending.bFromCache == false) && (NULL == pending.pImageData))
+		{
+			std::cout << "Could not load image:" << pending.filename << std::endl;
+			continue;
+		}
+
+		std::cout << "Successfully loaded image:" << pending.filename << ", width:" << pending.width << ", height:" << pending.height << ", channels:" << pending.colorChannels << std::endl;
+
+		if ((m_bUseTextureArrays == true) && (m_bTextureArraysBuilt == false))
+		{
+			// hold the finished decode until every texture is in and
+			// the arrays can be grouped by matching size
+			m_decodedTextures.push_back(std::move(pending));
+			continue;
+		}
+
+		GLenum internalFormat = GL_RGB8;
+		GLenum format = GL_RGB;
+		// if the loaded image is in RGBA format - it supports transparency
+		if (pending.colorChannels == 4)
+		{
+			internalFormat = GL_RGBA8;
+			format = GL_RGBA;
+		}
+		else if (pending.colorChannels != 3)
+		{
+			std::cout << "Not implemented to handle image with " << pending.colorChannels << " channels" << std::endl;
+			if (NULL != pending.pImageData)
+			{
+				stbi_image_free(pending.pImageData);
+			}
+			continue;
+		}
+
+		// the cached pixel rows are tightly packed regardless of width
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		// re-upload into the placeholder texture ID so every binding
+		// of the tag picks up the full image
+		glBindTexture(GL_TEXTURE_2D, m_textureIDs[pending.slot].ID);
+
+		if (pending.bFromCache == true)
+		{
+			// upload the baked mip chain level by level straight from
+			// the cache data - no mipmap generation is needed
+			size_t levelOffset = 0;
+			int levelWidth = pending.width;
+			int levelHeight = pending.height;
+
+			for (int level = 0; level < pending.levelCount; level++)
+			{
+				glTexImage2D(GL_TEXTURE_2D, level, internalFormat, levelWidth, levelHeight,
+					0, format, GL_UNSIGNED_BYTE, pending.cacheData.data() + levelOffset);
+
+				levelOffset += (size_t)levelWidth * levelHeight * pending.colorChannels;
+				levelWidth = (levelWidth > 1) ? (levelWidth / 2) : 1;
+				levelHeight = (levelHeight > 1) ? (levelHeight / 2) : 1;
+			}
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, pending.levelCount - 1);
+
+			glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+			continue;
+		}
+
+		// stage the pixels in the pixel buffer object so the texture
+		// upload happens from GPU-visible memory
+		GLsizeiptr imageBytes =
+			(GLsizeiptr)pending.width * pending.height * pending.colorChannels;
+		if (m_texturePBO == 0)
+		{
+			glGenBuffers(1, &m_texturePBO);
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_texturePBO);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, imageBytes, pending.pImageData, GL_STREAM_DRAW);
+
+		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, pending.width, pending.height,
+			0, format, GL_UNSIGNED_BYTE, (void*)0);
+
+		// generate the texture mipmaps for mapping textures to lower resolutions
+		glGenerateMipmap(GL_TEXTURE_2D);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		// bake the generated mip chain to disk so the next launch can
+		// skip both the decode and the mipmap generation
+		SaveTextureCache(pending.filename, format,
+			pending.width, pending.height, pending.colorChannels);
+
+		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+
+		// free the image data from local memory
+		stbi_image_free(pending.pImageData);
+	}
+
+	// once the last pending decode has drained - successfully or not -
+	// the held decodes can be grouped into the texture arrays
+	if ((m_bUseTextureArrays == true) && (m_bTextureArraysBuilt == false) &&
+		(m_pendingTextures.empty() == true) && (m_decodedTextures.empty() == false))
+	{
+		BuildTextureArrays();
+	}
+}
+
+/***********************************************************
+ *  SaveTextureCache()
+ *
+ *  This method reads the mip chain of the currently bound
+ *  texture back from the GPU and writes it into a cache
+ *  file next to the source image, keyed by the modification
+ *  time of the source file.  On the next launch the cache
+ *  is loaded with a single read instead of decoding the
+ *  image and regenerating the mipmaps.
+ ***********************************************************/
+void SceneManager::SaveTextureCache(
+	const std::string& filename,
+	GLenum format,
+	int width,
+	int height,
+	int colorChannels)
+{
+	std::string cacheFilename = filename + g_TextureCacheExtension;
+	TEXTURE_CACHE_HEADER header;
+	std::vector<unsigned char> levelPixels;
+	int levelWidth = width;
+	int levelHeight = height;
+
+	// count the levels of the full mip chain down to 1x1
+	int levelCount = 1;
+	while ((levelWidth > 1) || (levelHeight > 1))
+	{
+		levelWidth = (levelWidth > 1) ? (levelWidth / 2) : 1;
+		levelHeight = (levelHeight > 1) ? (levelHeight / 2) : 1;
+		levelCount++;
+	}
+
+	FILE* pCacheFile = fopen(cacheFilename.c_str(), "wb");
+	if (NULL == pCacheFile)
+	{
+		std::cout << "Could not write texture cache:" << cacheFilename << std::endl;
+		return;
+	}
+
+	memcpy(header.magic, g_TextureCacheMagic, sizeof(g_TextureCacheMagic));
+	header.sourceModTime = GetFileModTime(filename);
+	header.width = width;
+	header.height = height;
+	header.colorChannels = colorChannels;
+	header.levelCount = levelCount;
+	fwrite(&header, sizeof(header), 1, pCacheFile);
+
+	// read each level back tightly packed and append it to the file
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	levelWidth = width;
+	levelHeight = height;
+	for (int level = 0; level < levelCount; level++)
+	{
+		levelPixels.resize((size_t)levelWidth * levelHeight * colorChannels);
+		glGetTexImage(GL_TEXTURE_2D, level, format, GL_UNSIGNED_BYTE, levelPixels.data());
+		fwrite(levelPixels.data(), 1, levelPixels.size(), pCacheFile);
+
+		levelWidth = (levelWidth > 1) ? (levelWidth / 2) : 1;
+		levelHeight = (levelHeight > 1) ? (levelHeight / 2) : 1;
+	}
+	fclose(pCacheFile);
+
+	std::cout << "Saved texture cache:" << cacheFilename << std::endl;
+}
+
+/***********************************************************
+ *  BuildTextureArrays()
+ *
+ *  This method groups the held texture decodes by matching
+ *  size and channel count into GL_TEXTURE_2D_ARRAY textures,
+ *  one layer per texture.  Each array is bound to its own
+ *  texture unit once and stays bound, so SetShaderTexture()
+ *  only has to send a layer index - no texture binding
+ *  changes per object and no hard cap of one texture per
+ *  texture unit.  The mipmaps are regenerated on the array,
+ *  so cached mip chains only supply the base level here.
+ ***********************************************************/
+void SceneManager::BuildTextureArrays()
+{
+	m_textureArrayIndex.assign(m_loadedTextures, -1);
+	m_textureLayer.assign(m_loadedTextures, 0);
+
+	// assign every decoded texture to the array matching its size,
+	// creating a new array entry for each size seen for the first time
+	for (int i = 0; i < (int)m_decodedTextures.size(); i++)
+	{
+		PENDING_TEXTURE& decoded = m_decodedTextures[i];
+		int arrayIndex = -1;
+
+		for (int j = 0; j < (int)m_textureArrays.size(); j++)
+		{
+			if ((m_textureArrays[j].width == decoded.width) &&
+				(m_textureArrays[j].height == decoded.height) &&
+				(m_textureArrays[j].colorChannels == decoded.colorChannels))
+			{
+				arrayIndex = j;
+				break;
+			}
+		}
+		if (arrayIndex < 0)
+		{
+			TEXTURE_ARRAY_INFO arrayInfo;
+			arrayInfo.ID = 0;
+			arrayInfo.width = decoded.width;
+			arrayInfo.height = decoded.height;
+			arrayInfo.colorChannels = decoded.colorChannels;
+			arrayInfo.textureUnit = (int)m_textureArrays.size();
+			m_textureArrays.push_back(arrayInfo);
+			arrayIndex = (int)m_textureArrays.size() - 1;
+		}
+
+		m_textureArrayIndex[decoded.slot] = arrayIndex;
+	}
+
+	// the decoded pixel rows are tightly packed regardless of width
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	// create each array, upload its layers, and bind it to its unit
+	for (int j = 0; j < (int)m_textureArrays.size(); j++)
+	{
+		TEXTURE_ARRAY_INFO& arrayInfo = m_textureArrays[j];
+		GLenum internalFormat = (arrayInfo.colorChannels == 4) ? GL_RGBA8 : GL_RGB8;
+		GLenum format = (arrayInfo.colorChannels == 4) ? GL_RGBA : GL_RGB;
+		int layerCount = 0;
+		int layer = 0;
+
+		for (int i = 0; i < (int)m_decodedTextures.size(); i++)
+		{
+			if (m_textureArrayIndex[m_decodedTextures[i].slot] == j)
+			{
+				layerCount++;
+			}
+		}
+
+		glGenTextures(1, &arrayInfo.ID);
+		LabelGLObject(GL_TEXTURE, arrayInfo.ID, "TextureArray." + std::to_string(j));
+		glBindTexture(GL_TEXTURE_2D_ARRAY, arrayInfo.ID);
+
+		// set the texture wrapping parameters
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		// set texture filtering parameters
+		ApplyTextureFilter(GL_TEXTURE_2D_ARRAY, filterAnisotropic);
+
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, internalFormat,
+			arrayInfo.width, arrayInfo.height, layerCount,
+			0, format, GL_UNSIGNED_BYTE, NULL);
+
+		for (int i = 0; i < (int)m_decodedTextures.size(); i++)
+		{
+			PENDING_TEXTURE& decoded = m_decodedTextures[i];
+
+			if (m_textureArrayIndex[decoded.slot] != j)
+			{
+				continue;
+			}
+
+			const unsigned char* pPixels = (decoded.bFromCache == true) ?
+				decoded.cacheData.data() : decoded.pImageData;
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer,
+				arrayInfo.width, arrayInfo.height, 1,
+				format, GL_UNSIGNED_BYTE, pPixels);
+
+			m_textureLayer[decoded.slot] = layer;
+			layer++;
+		}
+
+		// generate the texture mipmaps for mapping textures to lower resolutions
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+		// bind the array to its texture unit once - it stays bound for
+		// the rest of the run
+		glActiveTexture(GL_TEXTURE0 + arrayInfo.textureUnit);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, arrayInfo.ID);
+	}
+	glActiveTexture(GL_TEXTURE0);
+
+	// free the image data that was held back for the array build
+	for (int i = 0; i < (int)m_decodedTextures.size(); i++)
+	{
+		if (NULL != m_decodedTextures[i].pImageData)
+		{
+			stbi_image_free(m_decodedTextures[i].pImageData);
+		}
+	}
+	m_decodedTextures.clear();
+	m_bTextureArraysBuilt = true;
+
+	// the texture shadow state now refers to array units and layers
+	m_lastTextureSlot = -2;
+	m_lastTextureLayer = -2;
+
+	std::cout << "Packed " << m_loadedTextures << " textures into " << m_textureArrays.size() << " texture arrays" << std::endl;
+}
+
+/***********************************************************
+ *  BindGLTextures()
+ *
+ *  This method is used for binding the loaded textures to
+ *  OpenGL texture memory slots.  There are up to 16 slots.
+ ***********************************************************/
+void SceneManager::BindGLTextures()
+{
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		// bind textures on corresponding texture units
+		glActiveTexture(GL_TEXTURE0 + i);
+		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
+	}
+}
+
+/***********************************************************
+ *  DestroyGLTextures()
+ *
+ *  This method is used for freeing the memory in all the
+ *  used texture memory slots.
+ ***********************************************************/
+void SceneManager::DestroyGLTextures()
+{
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		glGenTextures(1, &m_textureIDs[i].ID);
+	}
+
+	// free the texture arrays built for the array backend
+	for (int i = 0; i < (int)m_textureArrays.size(); i++)
+	{
+		glDeleteTextures(1, &m_textureArrays[i].ID);
+	}
+	m_textureArrays.clear();
+}
+
+/***********************************************************
+ *  FindTextureID()
+ *
+ *  This method is used for getting an ID for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureID(std::string tag)
+{
+	int textureID = -1;
+	int index = 0;
+	bool bFound = false;
+
+	while ((index < m_loadedTextures) && (bFound == false))
+	{
+		if (m_textureIDs[index].tag.compare(tag) == 0)
+		{
+			textureID = m_textureIDs[index].ID;
+			bFound = true;
+		}
+		else
+			index++;
+	}
+
+	return(textureID);
+}
+
+/***********************************************************
+ *  FindTextureSlot()
+ *
+ *  This method is used for getting a slot index for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureSlot(std::string tag)
+{
+	int textureSlot = -1;
+	int index = 0;
+	bool bFound = false;
+
+	while ((index < m_loadedTextures) && (bFound == false))
+	{
+		if (m_textureIDs[index].tag.compare(tag) == 0)
+		{
+			textureSlot = index;
+			bFound = true;
+		}
+		else
+			index++;
+	}
+
+	return(textureSlot);
+}
+
+/***********************************************************
+ *  FindMaterial()
+ *
+ *  This method is used for getting a material from the previously
+ *  defined materials list that is associated with the passed in tag.
+ ***********************************************************/
+bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
+{
+	if (m_objectMaterials.size() == 0)
+	{
+		return(false);
+	}
+
+	int index = 0;
+	bool bFound = false;
+	while ((index < m_objectMaterials.size()) && (bFound == false))
+	{
+		if (m_objectMaterials[index].tag.compare(tag) == 0)
+		{
+			bFound = true;
+			material.diffuseColor = m_objectMaterials[index].diffuseColor;
+			material.specularColor = m_objectMaterials[index].specularColor;
+			material.shininess = m_objectMaterials[index].shininess;
+		}
+		else
+		{
+			index++;
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  AddObjectMaterial()
+ *
+ *  This method registers the passed in object material and
+ *  returns its integer handle.  The handle indexes straight
+ *  into the material list and the material uniform block,
+ *  so it can be passed to SetShaderMaterial() without a tag
+ *  lookup per object.
+ ***********************************************************/
+int SceneManager::AddObjectMaterial(const OBJECT_MATERIAL& material)
+{
+	m_objectMaterials.push_back(material);
+
+	return((int)m_objectMaterials.size() - 1);
+}
+
+/***********************************************************
+ *  SetTransformations()
+ *
+ *  This method is used for setting the transform buffer
+ *  using the passed in transformation values.
+ ***********************************************************/
+void SceneManager::SetTransformations(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	// variables for this method
+	glm::mat4 modelView;
+	glm::mat4 scale;
+	glm::mat4 rotationX;
+	glm::mat4 rotationY;
+	glm::mat4 rotationZ;
+	glm::mat4 translation;
+
+	// set the scale value in the transform buffer
+	scale = glm::scale(scaleXYZ);
+	// set the rotation values in the transform buffer
+	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
+	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
+	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
+	// set the translation value in the transform buffer
+	translation = glm::translate(positionXYZ);
+
+	modelView = translation * rotationZ * rotationY * rotationX * scale;
+
+	// keep the matrix and position with the draw state - the position
+	// is needed for distance based LOD selection and, together with
+	// the bounding radius, for view-frustum visibility tests.  The
+	// basic shapes all fit inside two local units of their origin, so
+	// twice the largest scale factor is a conservative world bound
+	m_currentDrawItem.modelMatrix = modelView;
+	m_currentDrawItem.positionXYZ = positionXYZ;
+	m_currentDrawItem.boundingRadius = 2.0f * glm::max(
+		glm::abs(scaleXYZ.x), glm::max(glm::abs(scaleXYZ.y), glm::abs(scaleXYZ.z)));
+
+	if (m_bRecordingDraws == true)
+	{
+		return;
+	}
+
+	ApplyModelMatrix(modelView);
+}
+
+/***********************************************************
+ *  ApplyModelMatrix()
+ *
+ *  This method uploads the passed in model matrix for the
+ *  next draw - through the transform ring buffer when it is
+ *  available, otherwise through the model matrix uniform.
+ ***********************************************************/
+void SceneManager::ApplyModelMatrix(const glm::mat4& modelMatrix)
+{
+	if (m_bUseTransformBuffer == true &&
+		m_transformSlotIndex < m_transformSlotsPerFrame)
+	{
+		// write the model matrix into the next slot of the mapped ring
+		// buffer and point the transform block at that slot - no
+		// glUniform* traffic is needed for the draw
+		GLintptr slotOffset =
+			((GLintptr)m_transformFrameIndex * m_transformSlotsPerFrame + m_transformSlotIndex) *
+			m_transformSlotSize;
+		memcpy(m_pTransformBufferData + slotOffset, glm::value_ptr(modelMatrix), sizeof(glm::mat4));
+		glBindBufferRange(GL_UNIFORM_BUFFER, g_TransformBlockBinding,
+			m_transformUBO, slotOffset, sizeof(glm::mat4));
+		m_transformSlotIndex++;
+	}
+	else if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setMat4Value(m_hModelMatrix, modelMatrix);
+		m_frameUniformUpdates++;
+	}
+}
+
+/***********************************************************
+ *  SetShaderColor()
+ *
+ *  This method is used for setting the passed in color
+ *  into the shader for the next draw command
+ ***********************************************************/
+void SceneManager::SetShaderColor(
+	float redColorValue,
+	float greenColorValue,
+	float blueColorValue,
+	float alphaValue)
+{
+	// variables for this method
+	glm::vec4 currentColor;
+
+	currentColor.r = redColorValue;
+	currentColor.g = greenColorValue;
+	currentColor.b = blueColorValue;
+	currentColor.a = alphaValue;
+
+	if (m_bRecordingDraws == true)
+	{
+		m_currentDrawItem.bUseTexture = false;
+		m_currentDrawItem.color = currentColor;
+		return;
+	}
+
+	if (NULL != m_pShaderManager)
+	{
+		// only send the values that differ from the last update
+		if (m_lastUseTexture != 0)
+		{
+			m_pShaderManager->setIntValue(m_hUseTexture, false);
+			m_lastUseTexture = 0;
+			m_frameStateChanges++;
+			m_frameUniformUpdates++;
+		}
+		if (m_lastColor != currentColor)
+		{
+			m_pShaderManager->setVec4Value(m_hColorValue, currentColor);
+			m_lastColor = currentColor;
+			m_frameUniformUpdates++;
+		}
+	}
+}
+
+/***********************************************************
+ *  SetShaderTexture()
+ *
+ *  This method is used for setting the texture data
+ *  associated with the passed in ID into the shader.
+ ***********************************************************/
+void SceneManager::SetShaderTexture(
+	std::string textureTag)
+{
+	// the tag lookup is kept as a load-time convenience - the draw
+	// path should pass the handle returned at registration instead
+	SetShaderTexture(FindTextureSlot(textureTag));
+}
+
+/***********************************************************
+ *  SetShaderTexture()
+ *
+ *  This method is used for setting the texture data
+ *  associated with the passed in handle into the shader.
+ ***********************************************************/
+void SceneManager::SetShaderTexture(
+	int textureHandle)
+{
+	if (m_bRecordingDraws == true)
+	{
+		m_currentDrawItem.bUseTexture = true;
+		m_currentDrawItem.textureHandle = textureHandle;
+		return;
+	}
+
+	if (NULL != m_pShaderManager)
+	{
+		// only send the values that differ from the last update
+		if (m_lastUseTexture != 1)
+		{
+			m_pShaderManager->setIntValue(m_hUseTexture, true);
+			m_lastUseTexture = 1;
+			m_frameStateChanges++;
+			m_frameUniformUpdates++;
+		}
+
+		// in array mode the texture is addressed by its array's unit
+		// and its layer index - the arrays stay bound, so no texture
+		// binding changes are needed per object
+		if ((m_bTextureArraysBuilt == true) && (textureHandle >= 0) &&
+			(m_textureArrayIndex[textureHandle] >= 0))
+		{
+			int textureUnit = m_textureArrays[m_textureArrayIndex[textureHandle]].textureUnit;
+			int layer = m_textureLayer[textureHandle];
+
+			if ((m_lastTextureSlot != textureUnit) || (m_lastTextureLayer != layer))
+			{
+				m_pShaderManager->setSampler2DValue(m_hTextureArray, textureUnit);
+				m_pShaderManager->setIntValue(m_hTextureLayer, layer);
+				m_lastTextureSlot = textureUnit;
+				m_lastTextureLayer = layer;
+				m_frameStateChanges++;
+				m_frameUniformUpdates += 2;
+			}
+			return;
+		}
+
+		if (m_lastTextureSlot != textureHandle)
+		{
+			m_pShaderManager->setSampler2DValue(m_hTextureValue, textureHandle);
+			m_lastTextureSlot = textureHandle;
+			m_frameStateChanges++;
+			m_frameUniformUpdates++;
+		}
+	}
+}
+
+/***********************************************************
+ *  SetTextureUVScale()
+ *
+ *  This method is used for setting the texture UV scale
+ *  values into the shader.
+ ***********************************************************/
+void SceneManager::SetTextureUVScale(float u, float v)
+{
+	if (m_bRecordingDraws == true)
+	{
+		m_currentDrawItem.uvScale = glm::vec2(u, v);
+		return;
+	}
+
+	if (NULL != m_pShaderManager)
+	{
+		// drop the update when the same scale is already set
+		glm::vec2 uvScale = glm::vec2(u, v);
+
+		if (m_lastUVScale != uvScale)
+		{
+			m_pShaderManager->setVec2Value(m_hUVscale, uvScale);
+			m_lastUVScale = uvScale;
+			m_frameUniformUpdates++;
+		}
+	}
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ *
+ *  This method is used for passing the material values
+ *  into the shader.
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(
+	std::string materialTag)
+{
+	// the tag lookup is kept as a load-time convenience - the draw
+	// path should pass the handle returned by AddObjectMaterial()
+	for (int index = 0; index < m_objectMaterials.size(); index++)
+	{
+		if (m_objectMaterials[index].tag.compare(materialTag) == 0)
+		{
+			SetShaderMaterial(index);
+			return;
+		}
+	}
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ *
+ *  This method is used for passing the material values
+ *  associated with the passed in handle into the shader.
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(
+	int materialHandle)
+{
+	if (m_bRecordingDraws == true)
+	{
+		m_currentDrawItem.materialHandle = materialHandle;
+		return;
+	}
+
+	if ((materialHandle < 0) || (materialHandle >= (int)m_objectMaterials.size()))
+	{
+		return;
+	}
+
+	// drop the update when the same material is already set
+	if (m_lastMaterialHandle == materialHandle)
+	{
+		return;
+	}
+	m_lastMaterialHandle = materialHandle;
+	m_frameStateChanges++;
+
+	if (m_bUseMaterialBuffer == true)
+	{
+		// with the material block uploaded during scene prep, only
+		// the index of the material needs to be sent per object
+		m_pShaderManager->setIntValue(m_hMaterialIndex, materialHandle);
+		m_frameUniformUpdates++;
+		return;
+	}
+
+	const OBJECT_MATERIAL& material = m_objectMaterials[materialHandle];
+	m_pShaderManager->setVec3Value(m_hMaterialDiffuseColor, material.diffuseColor);
+	m_pShaderManager->setVec3Value(m_hMaterialSpecularColor, material.specularColor);
+	m_pShaderManager->setFloatValue(m_hMaterialShininess, material.shininess);
+	m_frameUniformUpdates += 3;
+}
+
+/***********************************************************
+ *  CommitDrawItem()
+ *
+ *  This method finishes one mesh draw of the scene.  In
+ *  record mode the accumulated draw item is appended to the
+ *  draw list; otherwise the draw is issued immediately with
+ *  the shader state that is already set.
+ ***********************************************************/
+void SceneManager::CommitDrawItem()
+{
+	if (m_bRecordingDraws == true)
+	{
+		m_drawList.push_back(m_currentDrawItem);
+		return;
+	}
+
+	DrawItemMesh(m_currentDrawItem);
+}
+
+/***********************************************************
+ *  DrawItemMesh()
+ *
+ *  This method issues the mesh draw of the passed in draw
+ *  item.
+ ***********************************************************/
+void SceneManager::DrawItemMesh(const DRAW_ITEM& item)
+{
+	m_frameDrawCalls++;
+
+	switch (item.meshID)
+	{
+	case drawBox:
+		m_basicMeshes->DrawBoxMesh();
+		break;
+	case drawBoxSide:
+		m_basicMeshes->DrawBoxMeshSide(item.boxSide);
+		break;
+	case drawCylinder:
+		m_basicMeshes->DrawCylinderMesh(item.bDrawTop, item.bDrawBottom, item.bDrawSides);
+		break;
+	case drawHalfSphere:
+		m_basicMeshes->DrawHalfSphereMesh();
+		break;
+	case drawTorusLOD:
+		m_basicMeshes->DrawTorusMeshLOD(
+			glm::distance(ViewManager::GetCameraPosition(), item.positionXYZ));
+		break;
+	}
+}
+
+/***********************************************************
+ *  SortDrawList()
+ *
+ *  This method sorts the recorded draw list by texture,
+ *  then material, then mesh, so replaying the list makes
+ *  the fewest possible GL state transitions regardless of
+ *  the authoring order of the Render* methods.
+ ***********************************************************/
+void SceneManager::SortDrawList()
+{
+	std::sort(m_drawList.begin(), m_drawList.end(),
+		[](const DRAW_ITEM& itemA, const DRAW_ITEM& itemB)
+		{
+			// untextured draws group together in front of the textures
+			int textureA = (itemA.bUseTexture == true) ? itemA.textureHandle : -1;
+			int textureB = (itemB.bUseTexture == true) ? itemB.textureHandle : -1;
+
+			if (textureA != textureB)
+			{
+				return (textureA < textureB);
+			}
+			if (itemA.materialHandle != itemB.materialHandle)
+			{
+				return (itemA.materialHandle < itemB.materialHandle);
+			}
+			return (itemA.meshID < itemB.meshID);
+		});
+}
+
+/***********************************************************
+ *  ExtractFrustumPlanes()
+ *
+ *  This method extracts the six view-frustum planes from
+ *  the combined projection * view matrix of the current
+ *  frame.  Each plane is stored as (normal, distance) and
+ *  normalized, so a signed point distance is a single dot
+ *  product.
+ ***********************************************************/
+void SceneManager::ExtractFrustumPlanes(glm::vec4 planes[6])
+{
+	glm::mat4 matrix = glm::transpose(ViewManager::GetViewProjectionMatrix());
+
+	planes[0] = matrix[3] + matrix[0];	// left
+	planes[1] = matrix[3] - matrix[0];	// right
+	planes[2] = matrix[3] + matrix[1];	// bottom
+	planes[3] = matrix[3] - matrix[1];	// top
+	planes[4] = matrix[3] + matrix[2];	// near
+	planes[5] = matrix[3] - matrix[2];	// far
+
+	for (int i = 0; i < 6; i++)
+	{
+		float length = glm::length(glm::vec3(planes[i]));
+
+		if (length > 0.0f)
+		{
+			planes[i] /= length;
+		}
+	}
+}
+
+/***********************************************************
+ *  IsSphereVisible()
+ *
+ *  This method tests the passed in bounding sphere against
+ *  the view-frustum planes - the sphere is visible unless
+ *  it lies completely behind one of the planes.
+ ***********************************************************/
+bool SceneManager::IsSphereVisible(const glm::vec4 planes[6],
+	const glm::vec3& center, float radius)
+{
+	for (int i = 0; i < 6; i++)
+	{
+		if (glm::dot(glm::vec3(planes[i]), center) + planes[i].w < -radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/***********************************************************
+ *  ReplayDrawList()
+ *
+ *  This method applies the captured shader state of each
+ *  recorded draw item and issues its draw, skipping items
+ *  whose bounding sphere falls outside the view frustum.
+ *  The torus LOD distance is re-evaluated every frame, so
+ *  camera movement still switches the mesh density.
+ ***********************************************************/
+void SceneManager::ReplayDrawList()
+{
+	glm::vec4 frustumPlanes[6];
+
+	ExtractFrustumPlanes(frustumPlanes);
+
+	// start from the state-sorted order of the recorded list
+	m_drawOrder.resize(m_drawList.size());
+	for (int i = 0; i < (int)m_drawOrder.size(); i++)
+	{
+		m_drawOrder[i] = i;
+	}
+
+	if (m_bSortFrontToBack == true)
+	{
+		// order the draws front to back so nearer surfaces are laid
+		// down first and covered fragments fail the depth test early -
+		// the shadow-state cache keeps the extra state switches cheap
+		glm::vec3 cameraPosition = ViewManager::GetCameraPosition();
+
+		std::sort(m_drawOrder.begin(), m_drawOrder.end(),
+			[this, cameraPosition](int indexA, int indexB)
+			{
+				return (glm::distance(cameraPosition, m_drawList[indexA].positionXYZ) <
+					glm::distance(cameraPosition, m_drawList[indexB].positionXYZ));
+			});
+	}
+
+	if (m_bDepthPrePass == true)
+	{
+		// lay down the final depth buffer without color writes, then
+		// let the lit pass repaint only the surviving front surfaces
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+		for (int i = 0; i < (int)m_drawOrder.size(); i++)
+		{
+			const DRAW_ITEM& item = m_drawList[m_drawOrder[i]];
+
+			if (IsItemVisible(frustumPlanes, item) == false)
+			{
+				continue;
+			}
+
+			ApplyModelMatrix(item.modelMatrix);
+			DrawItemMesh(item);
+		}
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+		glDepthFunc(GL_LEQUAL);
+	}
+
+	for (int i = 0; i < (int)m_drawOrder.size(); i++)
+	{
+		const DRAW_ITEM& item = m_drawList[m_drawOrder[i]];
+
+		if (IsItemVisible(frustumPlanes, item) == false)
+		{
+			continue;
+		}
+
+		ApplyModelMatrix(item.modelMatrix);
+
+		if (item.bUseTexture == true)
+		{
+			SetShaderTexture(item.textureHandle);
+		}
+		else
+		{
+			SetShaderColor(item.color.r, item.color.g, item.color.b, item.color.a);
+		}
+		SetTextureUVScale(item.uvScale.x, item.uvScale.y);
+		SetShaderMaterial(item.materialHandle);
+
+		DrawItemMesh(item);
+	}
+
+	if (m_bDepthPrePass == true)
+	{
+		glDepthFunc(GL_LESS);
+	}
+}
+
+/***********************************************************
+ *  IsItemVisible()
+ *
+ *  This method tests one draw item against the view-frustum
+ *  planes and the occlusion results of its draw group.
+ ***********************************************************/
+bool SceneManager::IsItemVisible(const glm::vec4 planes[6], const DRAW_ITEM& item)
+{
+	// the object cannot be on screen
+	if (IsSphereVisible(planes, item.positionXYZ, item.boundingRadius) == false)
+	{
+		return false;
+	}
+
+	// the item's group was fully occluded in the previous frame
+	if ((item.groupID >= 0) && (item.groupID < (int)m_drawGroups.size()) &&
+		(m_drawGroups[item.groupID].bVisible == false))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+/***********************************************************
+ *  SetFrontToBackSort()
+ *
+ *  This method enables/disables replaying the recorded
+ *  draws ordered front to back by camera distance.
+ ***********************************************************/
+void SceneManager::SetFrontToBackSort(bool bEnabled)
+{
+	m_bSortFrontToBack = bEnabled;
+}
+
+/***********************************************************
+ *  SetDepthPrePass()
+ *
+ *  This method enables/disables the depth-only pass that
+ *  runs before the lit pass.
+ ***********************************************************/
+void SceneManager::SetDepthPrePass(bool bEnabled)
+{
+	m_bDepthPrePass = bEnabled;
+}
+
+/***********************************************************
+ *  GetDrawCallCount()
+ *
+ *  This method returns the number of draw calls the
+ *  recorded scene submits per frame - one multi-draw per
+ *  bucket plus the leftovers on the indirect path, or one
+ *  call per recorded item on the replay path.
+ ***********************************************************/
+int SceneManager::GetDrawCallCount()
+{
+	if (m_bUseIndirectDraw == true)
+	{
+		return (int)m_indirectBuckets.size() + (int)m_indirectLeftoverItems.size();
+	}
+
+	return (int)m_drawList.size();
+}
+
+/***********************************************************
+ *  GetFrameCounters()
+ *
+ *  This method returns the instrumentation counters of the
+ *  most recently rendered frame.
+ ***********************************************************/
+void SceneManager::GetFrameCounters(int& drawCalls, int& stateChanges, int& uniformUpdates)
+{
+	drawCalls = m_frameDrawCalls;
+	stateChanges = m_frameStateChanges;
+	uniformUpdates = m_frameUniformUpdates;
+}
+
+/***********************************************************
+ *  BuildDrawGroups()
+ *
+ *  This method collects the world-space bounding box of
+ *  each recorded draw group from the bounding spheres of
+ *  its items and creates the occlusion query objects.
+ ***********************************************************/
+void SceneManager::BuildDrawGroups()
+{
+	int groupCount = 0;
+
+	for (int i = 0; i < (int)m_drawList.size(); i++)
+	{
+		if (m_drawList[i].groupID >= groupCount)
+		{
+			groupCount = m_drawList[i].groupID + 1;
+		}
+	}
+
+	m_drawGroups.resize(groupCount);
+	for (int j = 0; j < groupCount; j++)
 	{
-		glGenTextures(1, &m_textureIDs[i].ID);
+		m_drawGroups[j].boundsMin = glm::vec3(0.0f);
+		m_drawGroups[j].boundsMax = glm::vec3(0.0f);
+		m_drawGroups[j].bQueryIssued[0] = false;
+		m_drawGroups[j].bQueryIssued[1] = false;
+		m_drawGroups[j].bVisible = true;
+		glGenQueries(2, m_drawGroups[j].occlusionQuery);
+
+		bool bFirstItem = true;
+		for (int i = 0; i < (int)m_drawList.size(); i++)
+		{
+			const DRAW_ITEM& item = m_drawList[i];
+
+			if (item.groupID != j)
+			{
+				continue;
+			}
+
+			glm::vec3 itemMin = item.positionXYZ - glm::vec3(item.boundingRadius);
+			glm::vec3 itemMax = item.positionXYZ + glm::vec3(item.boundingRadius);
+
+			if (bFirstItem == true)
+			{
+				m_drawGroups[j].boundsMin = itemMin;
+				m_drawGroups[j].boundsMax = itemMax;
+				bFirstItem = false;
+			}
+			else
+			{
+				m_drawGroups[j].boundsMin = glm::min(m_drawGroups[j].boundsMin, itemMin);
+				m_drawGroups[j].boundsMax = glm::max(m_drawGroups[j].boundsMax, itemMax);
+			}
+		}
 	}
 }
 
 /***********************************************************
- *  FindTextureID()
+ *  UpdateGroupVisibility()
  *
- *  This method is used for getting an ID for the previously
- *  loaded texture bitmap associated with the passed in tag.
+ *  This method reads back the occlusion query results that
+ *  were issued in the previous frame.  A group whose proxy
+ *  passed no samples is marked invisible; when a result is
+ *  not yet available the previous visibility is kept rather
+ *  than stalling the pipeline.
  ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
+void SceneManager::UpdateGroupVisibility()
 {
-	int textureID = -1;
-	int index = 0;
-	bool bFound = false;
+	int readSlot = 1 - m_occlusionFrameParity;
 
-	while ((index < m_loadedTextures) && (bFound == false))
+	for (int j = 0; j < (int)m_drawGroups.size(); j++)
 	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
+		GLuint available = 0;
+		GLuint samplesPassed = 0;
+
+		if (m_drawGroups[j].bQueryIssued[readSlot] == false)
 		{
-			textureID = m_textureIDs[index].ID;
-			bFound = true;
+			continue;
 		}
-		else
-			index++;
-	}
 
-	return(textureID);
+		glGetQueryObjectuiv(m_drawGroups[j].occlusionQuery[readSlot],
+			GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available == 0)
+		{
+			continue;
+		}
+
+		glGetQueryObjectuiv(m_drawGroups[j].occlusionQuery[readSlot],
+			GL_QUERY_RESULT, &samplesPassed);
+		m_drawGroups[j].bVisible = (samplesPassed != 0);
+	}
 }
 
 /***********************************************************
- *  FindTextureSlot()
+ *  IssueOcclusionQueries()
  *
- *  This method is used for getting a slot index for the previously
- *  loaded texture bitmap associated with the passed in tag.
+ *  This method draws the bounding box proxy of each draw
+ *  group inside a GL_ANY_SAMPLES_PASSED query after the
+ *  real draws, with color and depth writes disabled.  The
+ *  proxies are depth tested against the rendered frame, so
+ *  a group fully behind the major occluders passes no
+ *  samples and is skipped next frame.
  ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
+void SceneManager::IssueOcclusionQueries()
 {
-	int textureSlot = -1;
-	int index = 0;
-	bool bFound = false;
+	int writeSlot = m_occlusionFrameParity;
 
-	while ((index < m_loadedTextures) && (bFound == false))
+	// the proxies only feed the queries - they must not be seen and
+	// must not change the depth buffer
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	glDepthMask(GL_FALSE);
+
+	for (int j = 0; j < (int)m_drawGroups.size(); j++)
 	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureSlot = index;
-			bFound = true;
-		}
-		else
-			index++;
+		// the box mesh spans one unit around its origin, so scaling
+		// by the extents and translating to the center covers the
+		// group's bounding box exactly
+		glm::vec3 center = (m_drawGroups[j].boundsMin + m_drawGroups[j].boundsMax) * 0.5f;
+		glm::vec3 extents = m_drawGroups[j].boundsMax - m_drawGroups[j].boundsMin;
+		glm::mat4 proxyMatrix = glm::translate(center) * glm::scale(extents);
+
+		glBeginQuery(GL_ANY_SAMPLES_PASSED, m_drawGroups[j].occlusionQuery[writeSlot]);
+		ApplyModelMatrix(proxyMatrix);
+		m_basicMeshes->DrawBoxMesh();
+		m_frameDrawCalls++;
+		glEndQuery(GL_ANY_SAMPLES_PASSED);
+		m_drawGroups[j].bQueryIssued[writeSlot] = true;
 	}
 
-	return(textureSlot);
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glDepthMask(GL_TRUE);
+
+	// next frame writes the other query while this one is read
+	m_occlusionFrameParity = 1 - m_occlusionFrameParity;
 }
 
 /***********************************************************
- *  FindMaterial()
+ *  BuildIndirectBuckets()
  *
- *  This method is used for getting a material from the previously
- *  defined materials list that is associated with the passed in tag.
+ *  This method bakes the state-sorted draw list into
+ *  GL_DRAW_INDIRECT_BUFFER commands grouped into buckets of
+ *  identical shader state, with the model matrix of every
+ *  command uploaded once into a uniform block the vertex
+ *  shader indexes by gl_DrawID.  Items that cannot be
+ *  expressed as indexed ranges of the consolidated mesh
+ *  buffers stay behind as leftover draws.
  ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
+void SceneManager::BuildIndirectBuckets()
 {
-	if (m_objectMaterials.size() == 0)
+	m_bUseIndirectDraw = false;
+
+	// the indirect path needs the multi-draw command support plus a
+	// shader that declares the matrix array block and the mode flag
+	if ((!GLEW_ARB_multi_draw_indirect) ||
+		(NULL == m_pShaderManager) || (m_hIndirectDrawFlag < 0))
 	{
-		return(false);
+		std::cout << "Indirect draws not supported, using the replay path" << std::endl;
+		return;
 	}
 
-	int index = 0;
-	bool bFound = false;
-	while ((index < m_objectMaterials.size()) && (bFound == false))
+	GLuint blockIndex = glGetUniformBlockIndex(
+		m_pShaderManager->m_programID, g_TransformArrayBlockName);
+	if (GL_INVALID_INDEX == blockIndex)
 	{
-		if (m_objectMaterials[index].tag.compare(tag) == 0)
+		std::cout << "Transform array block not found in shader, using the replay path" << std::endl;
+		return;
+	}
+
+	glUniformBlockBinding(
+		m_pShaderManager->m_programID, blockIndex, g_TransformArrayBlockBinding);
+
+	// each bucket's matrix range needs to start on a valid uniform
+	// buffer offset boundary for glBindBufferRange
+	GLint uniformAlignment = 256;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+
+	std::vector<DRAW_ELEMENTS_INDIRECT_COMMAND> commands;
+	std::vector<glm::mat4> matrices;
+
+	m_indirectBuckets.clear();
+	m_indirectLeftoverItems.clear();
+
+	for (int i = 0; i < (int)m_drawList.size(); i++)
+	{
+		const DRAW_ITEM& item = m_drawList[i];
+		std::vector<ShapeMeshes::DRAW_RANGE> ranges;
+		bool bHaveRanges = false;
+
+		// resolve the item's mesh into index ranges of the consolidated
+		// buffers - the box side draw is a non-indexed triangle fan and
+		// cannot be expressed as an indirect command
+		switch (item.meshID)
 		{
-			bFound = true;
-			material.diffuseColor = m_objectMaterials[index].diffuseColor;
-			material.specularColor = m_objectMaterials[index].specularColor;
-			material.shininess = m_objectMaterials[index].shininess;
+		case drawBox:
+			bHaveRanges = m_basicMeshes->GetBoxDrawRanges(ranges);
+			break;
+		case drawCylinder:
+			bHaveRanges = m_basicMeshes->GetCylinderDrawRanges(
+				item.bDrawTop, item.bDrawBottom, item.bDrawSides, ranges);
+			break;
+		case drawHalfSphere:
+			bHaveRanges = m_basicMeshes->GetHalfSphereDrawRanges(ranges);
+			break;
+		case drawTorusLOD:
+			// a baked command cannot switch meshes per frame, so the
+			// indirect path always draws the full-density torus
+			bHaveRanges = m_basicMeshes->GetTorusDrawRanges(ranges);
+			break;
+		default:
+			break;
 		}
-		else
+
+		if ((bHaveRanges == false) || (ranges.size() == 0))
 		{
-			index++;
+			m_indirectLeftoverItems.push_back(i);
+			continue;
 		}
-	}
-
-	return(true);
-}
 
-/***********************************************************
- *  SetTransformations()
- *
- *  This method is used for setting the transform buffer
- *  using the passed in transformation values.
- ***********************************************************/
-void SceneManager::SetTransformations(
-	glm::vec3 scaleXYZ,
-	float XrotationDegrees,
-	float YrotationDegrees,
-	float ZrotationDegrees,
-	glm::vec3 positionXYZ)
-{
-	// variables for this method
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
+		// open a new bucket when the shader state of the item differs
+		// from the current one, or the matrix array would overflow the
+		// block declared in the shader
+		bool bNewBucket = (m_indirectBuckets.size() == 0);
+		if (bNewBucket == false)
+		{
+			const INDIRECT_BUCKET& lastBucket = m_indirectBuckets.back();
+			bNewBucket =
+				(lastBucket.bUseTexture != item.bUseTexture) ||
+				(lastBucket.textureHandle != item.textureHandle) ||
+				(lastBucket.color != item.color) ||
+				(lastBucket.uvScale != item.uvScale) ||
+				(lastBucket.materialHandle != item.materialHandle) ||
+				(lastBucket.commandCount + (int)ranges.size() > g_MaxIndirectDraws);
+		}
 
-	// set the scale value in the transform buffer
-	scale = glm::scale(scaleXYZ);
-	// set the rotation values in the transform buffer
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	// set the translation value in the transform buffer
-	translation = glm::translate(positionXYZ);
+		if (bNewBucket == true)
+		{
+			// pad the matrix array up to the next aligned offset - the
+			// matrices are 64 bytes, so whole matrices land on any power
+			// of two alignment boundary
+			while ((((GLintptr)matrices.size() * sizeof(glm::mat4)) % uniformAlignment) != 0)
+			{
+				matrices.push_back(glm::mat4(1.0f));
+			}
+
+			INDIRECT_BUCKET bucket;
+			bucket.bUseTexture = item.bUseTexture;
+			bucket.textureHandle = item.textureHandle;
+			bucket.color = item.color;
+			bucket.uvScale = item.uvScale;
+			bucket.materialHandle = item.materialHandle;
+			bucket.commandOffset =
+				(GLsizeiptr)commands.size() * sizeof(DRAW_ELEMENTS_INDIRECT_COMMAND);
+			bucket.commandCount = 0;
+			bucket.matrixOffset = (GLintptr)matrices.size() * sizeof(glm::mat4);
+			m_indirectBuckets.push_back(bucket);
+		}
 
-	modelView = translation * rotationZ * rotationY * rotationX * scale;
+		// one command per range, each consuming one gl_DrawID slot of
+		// the bucket's matrix array
+		for (int j = 0; j < (int)ranges.size(); j++)
+		{
+			DRAW_ELEMENTS_INDIRECT_COMMAND command;
+			command.count = ranges[j].indexCount;
+			command.instanceCount = 1;
+			command.firstIndex = ranges[j].firstIndex;
+			command.baseVertex = (GLuint)ranges[j].baseVertex;
+			command.baseInstance = 0;
+			commands.push_back(command);
+			matrices.push_back(item.modelMatrix);
+			m_indirectBuckets.back().commandCount++;
+		}
+	}
 
-	if (NULL != m_pShaderManager)
+	if (commands.size() == 0)
 	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
+		// nothing could be baked - the meshes were not consolidated
+		m_indirectBuckets.clear();
+		m_indirectLeftoverItems.clear();
+		return;
 	}
+
+	// the scene is static, so the command and matrix buffers are
+	// uploaded once and reused every frame
+	glGenBuffers(1, &m_indirectBuffer);
+	LabelGLObject(GL_BUFFER, m_indirectBuffer, "SceneManager.indirectCommandBuffer");
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER,
+		(GLsizeiptr)commands.size() * sizeof(DRAW_ELEMENTS_INDIRECT_COMMAND),
+		&commands[0], GL_STATIC_DRAW);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+	glGenBuffers(1, &m_indirectMatrixUBO);
+	LabelGLObject(GL_BUFFER, m_indirectMatrixUBO, "SceneManager.indirectMatrixBuffer");
+	glBindBuffer(GL_UNIFORM_BUFFER, m_indirectMatrixUBO);
+	glBufferData(GL_UNIFORM_BUFFER,
+		(GLsizeiptr)matrices.size() * sizeof(glm::mat4),
+		&matrices[0], GL_STATIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	m_bUseIndirectDraw = true;
+	std::cout << "Baked " << commands.size() << " indirect draws into "
+		<< m_indirectBuckets.size() << " buckets" << std::endl;
 }
 
 /***********************************************************
- *  SetShaderColor()
+ *  SubmitIndirectDraws()
  *
- *  This method is used for setting the passed in color
- *  into the shader for the next draw command
+ *  This method submits the baked command buckets - one
+ *  glMultiDrawElementsIndirect call per shader state - and
+ *  then draws the leftover items the classic way.
  ***********************************************************/
-void SceneManager::SetShaderColor(
-	float redColorValue,
-	float greenColorValue,
-	float blueColorValue,
-	float alphaValue)
+void SceneManager::SubmitIndirectDraws()
 {
-	// variables for this method
-	glm::vec4 currentColor;
+	if (m_basicMeshes->BindConsolidatedVAO() == false)
+	{
+		return;
+	}
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
 
-	currentColor.r = redColorValue;
-	currentColor.g = greenColorValue;
-	currentColor.b = blueColorValue;
-	currentColor.a = alphaValue;
+	// switch the vertex shader to the gl_DrawID indexed matrix array
+	m_pShaderManager->setIntValue(m_hIndirectDrawFlag, true);
 
-	if (NULL != m_pShaderManager)
+	for (int j = 0; j < (int)m_indirectBuckets.size(); j++)
+	{
+		const INDIRECT_BUCKET& bucket = m_indirectBuckets[j];
+
+		// the shared shader state of the bucket goes through the
+		// redundant-state filtered setters
+		if (bucket.bUseTexture == true)
+		{
+			SetShaderTexture(bucket.textureHandle);
+		}
+		else
+		{
+			SetShaderColor(bucket.color.r, bucket.color.g, bucket.color.b, bucket.color.a);
+		}
+		SetTextureUVScale(bucket.uvScale.x, bucket.uvScale.y);
+		SetShaderMaterial(bucket.materialHandle);
+
+		// point the matrix block at the bucket's range of model matrices
+		glBindBufferRange(GL_UNIFORM_BUFFER, g_TransformArrayBlockBinding,
+			m_indirectMatrixUBO, bucket.matrixOffset,
+			(GLsizeiptr)bucket.commandCount * sizeof(glm::mat4));
+
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+			(const void*)bucket.commandOffset, bucket.commandCount, 0);
+		m_frameDrawCalls++;
+	}
+
+	m_pShaderManager->setIntValue(m_hIndirectDrawFlag, false);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	m_basicMeshes->UnbindConsolidatedVAO();
+
+	// the items that could not be baked still draw the classic way
+	for (int i = 0; i < (int)m_indirectLeftoverItems.size(); i++)
 	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
+		const DRAW_ITEM& item = m_drawList[m_indirectLeftoverItems[i]];
+
+		ApplyModelMatrix(item.modelMatrix);
+		if (item.bUseTexture == true)
+		{
+			SetShaderTexture(item.textureHandle);
+		}
+		else
+		{
+			SetShaderColor(item.color.r, item.color.g, item.color.b, item.color.a);
+		}
+		SetTextureUVScale(item.uvScale.x, item.uvScale.y);
+		SetShaderMaterial(item.materialHandle);
+		DrawItemMesh(item);
 	}
 }
 
 /***********************************************************
- *  SetShaderTexture()
+ *  DrawSceneBoxMesh() / DrawSceneBoxMeshSide() /
+ *  DrawSceneCylinderMesh() / DrawSceneHalfSphereMesh() /
+ *  DrawSceneTorusMeshLOD()
  *
- *  This method is used for setting the texture data
- *  associated with the passed in ID into the shader.
+ *  Draw dispatch used by the Render* methods - each one
+ *  stamps the mesh variant into the current draw item and
+ *  commits it.
  ***********************************************************/
-void SceneManager::SetShaderTexture(
-	std::string textureTag)
+void SceneManager::DrawSceneBoxMesh()
 {
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
+	m_currentDrawItem.meshID = drawBox;
+	CommitDrawItem();
+}
 
-		int textureID = -1;
-		textureID = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureID);
-	}
+void SceneManager::DrawSceneBoxMeshSide(ShapeMeshes::BoxSide side)
+{
+	m_currentDrawItem.meshID = drawBoxSide;
+	m_currentDrawItem.boxSide = side;
+	CommitDrawItem();
 }
 
-/***********************************************************
- *  SetTextureUVScale()
- *
- *  This method is used for setting the texture UV scale
- *  values into the shader.
- ***********************************************************/
-void SceneManager::SetTextureUVScale(float u, float v)
+void SceneManager::DrawSceneCylinderMesh(bool bDrawTop, bool bDrawBottom, bool bDrawSides)
 {
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
-	}
+	m_currentDrawItem.meshID = drawCylinder;
+	m_currentDrawItem.bDrawTop = bDrawTop;
+	m_currentDrawItem.bDrawBottom = bDrawBottom;
+	m_currentDrawItem.bDrawSides = bDrawSides;
+	CommitDrawItem();
 }
 
-/***********************************************************
- *  SetShaderMaterial()
- *
- *  This method is used for passing the material values
- *  into the shader.
- ***********************************************************/
-void SceneManager::SetShaderMaterial(
-	std::string materialTag)
+void SceneManager::DrawSceneHalfSphereMesh()
 {
-	if (m_objectMaterials.size() > 0)
-	{
-		OBJECT_MATERIAL material;
-		bool bReturn = false;
+	m_currentDrawItem.meshID = drawHalfSphere;
+	CommitDrawItem();
+}
 
-		bReturn = FindMaterial(materialTag, material);
-		if (bReturn == true)
-		{
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
-		}
-	}
+void SceneManager::DrawSceneTorusMeshLOD()
+{
+	// the object position was captured by SetTransformations() - the
+	// viewer distance is computed when the draw is issued
+	m_currentDrawItem.meshID = drawTorusLOD;
+	CommitDrawItem();
 }
 
 /**************************************************************/
@@ -386,7 +2555,7 @@ void SceneManager::DefineObjectMaterials()
 	woodMaterial.shininess = 0.3; //Less dull highlights
 	woodMaterial.tag = "wood";
 
-	m_objectMaterials.push_back(woodMaterial);
+	m_woodMaterialHandle = AddObjectMaterial(woodMaterial);
 
 
 	OBJECT_MATERIAL plasticMaterial;
@@ -395,7 +2564,7 @@ void SceneManager::DefineObjectMaterials()
 	plasticMaterial.shininess = 0.02f; // Very dull highlights
 	plasticMaterial.tag = "plastic";
 
-	m_objectMaterials.push_back(plasticMaterial);
+	m_plasticMaterialHandle = AddObjectMaterial(plasticMaterial);
 
 
 
@@ -422,69 +2591,104 @@ void SceneManager::SetupSceneLights()
 	 // Enable lighting
 	m_pShaderManager->setBoolValue(g_UseLightingName, true);
 
+	// collect the complete lighting setup in one structure so it can
+	// either be uploaded to the lighting uniform block in a single
+	// call or sent through the individually named uniforms
+	LIGHTING_BLOCK_DATA lightingData = {};
+
 	// Ambient light for global illumination (soft, subtle light for realism)
-	m_pShaderManager->setVec3Value("ambientLight", glm::vec3(0.2f, 0.2f, 0.2f)); // Dim global light
+	lightingData.ambientLight = glm::vec4(0.2f, 0.2f, 0.2f, 0.0f); // Dim global light
 
 	// Directional light simulating sunlight coming from an angle
-	m_pShaderManager->setVec3Value("directionalLight.direction", glm::vec3(-0.3f, -1.0f, -0.5f));
-	m_pShaderManager->setVec3Value("directionalLight.ambient", glm::vec3(0.2f, 0.2f, 0.2f)); // Slight ambient
-	m_pShaderManager->setVec3Value("directionalLight.diffuse", glm::vec3(0.8f, 0.8f, 0.8f)); // Brighter diffuse light
-	m_pShaderManager->setVec3Value("directionalLight.specular", glm::vec3(1.0f, 1.0f, 1.0f)); // Specular highlights
-	m_pShaderManager->setBoolValue("directionalLight.bActive", true);
+	lightingData.directionalDirectionActive = glm::vec4(-0.3f, -1.0f, -0.5f, 1.0f);
+	lightingData.directionalAmbient = glm::vec4(0.2f, 0.2f, 0.2f, 0.0f); // Slight ambient
+	lightingData.directionalDiffuse = glm::vec4(0.8f, 0.8f, 0.8f, 0.0f); // Brighter diffuse light
+	lightingData.directionalSpecular = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f); // Specular highlights
 
 	// Spotlight focused on the center of the table
-	m_pShaderManager->setVec3Value("spotLight.position", glm::vec3(0.0f, 10.0f, 5.0f)); // Above the table
-	m_pShaderManager->setVec3Value("spotLight.direction", glm::vec3(0.0f, -1.0f, 0.0f)); // Downward
-	m_pShaderManager->setVec3Value("spotLight.ambient", glm::vec3(0.1f, 0.1f, 0.1f)); // Soft ambient
-	m_pShaderManager->setVec3Value("spotLight.diffuse", glm::vec3(1.0f, 0.9f, 0.8f)); // Warm light
-	m_pShaderManager->setVec3Value("spotLight.specular", glm::vec3(1.0f, 1.0f, 1.0f)); // Highlights
-	m_pShaderManager->setFloatValue("spotLight.cutOff", glm::cos(glm::radians(10.0f))); // Tight spotlight
-	m_pShaderManager->setFloatValue("spotLight.outerCutOff", glm::cos(glm::radians(30.0f))); // Soft edges
-	m_pShaderManager->setFloatValue("spotLight.constant", 1.0f);
-	m_pShaderManager->setFloatValue("spotLight.linear", 0.09f);
-	m_pShaderManager->setFloatValue("spotLight.quadratic", 0.032f);
-	m_pShaderManager->setBoolValue("spotLight.bActive", true);
+	lightingData.spotPositionActive = glm::vec4(0.0f, 10.0f, 5.0f, 1.0f); // Above the table
+	lightingData.spotDirection = glm::vec4(0.0f, -1.0f, 0.0f, 0.0f); // Downward
+	lightingData.spotAmbient = glm::vec4(0.1f, 0.1f, 0.1f, 0.0f); // Soft ambient
+	lightingData.spotDiffuse = glm::vec4(1.0f, 0.9f, 0.8f, 0.0f); // Warm light
+	lightingData.spotSpecular = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f); // Highlights
+	lightingData.spotParams = glm::vec4(
+		glm::cos(glm::radians(10.0f)), // Tight spotlight
+		glm::cos(glm::radians(30.0f)), // Soft edges
+		1.0f, 0.09f);
+	lightingData.spotParams2 = glm::vec4(0.032f, 0.0f, 0.0f, 0.0f);
+
+	// Point lights above the coffee mug, box item, trashcan, and
+	// wooden plank - all share the same color and attenuation values
+	glm::vec4 pointLightPositions[4] = {
+		glm::vec4(-11.0f, 8.0f, 6.0f, 1.0f), // Offset to point toward the mug
+		glm::vec4(-6.0f, 8.0f, 6.5f, 1.0f), // Offset to point toward the box
+		glm::vec4(3.0f, 8.0f, 4.0f, 1.0f), // Offset to point toward the trashcan
+		glm::vec4(9.0f, 8.0f, 6.0f, 1.0f) // Offset to point toward the plank
+	};
+	for (int i = 0; i < 4; i++)
+	{
+		lightingData.pointLights[i].positionActive = pointLightPositions[i];
+		lightingData.pointLights[i].ambient = glm::vec4(0.05f, 0.05f, 0.05f, 0.0f);
+		lightingData.pointLights[i].diffuse = glm::vec4(0.8f, 0.8f, 0.8f, 0.0f);
+		lightingData.pointLights[i].specular = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
+		lightingData.pointLights[i].attenuation = glm::vec4(1.0f, 0.14f, 0.07f, 0.0f);
+	}
+
+	// if the shader declares the lighting uniform block then the whole
+	// setup is uploaded in one buffer transfer
+	GLuint blockIndex = glGetUniformBlockIndex(
+		m_pShaderManager->m_programID, g_LightingBlockName);
+	if (GL_INVALID_INDEX != blockIndex)
+	{
+		glUniformBlockBinding(
+			m_pShaderManager->m_programID, blockIndex, g_LightingBlockBinding);
+
+		glGenBuffers(1, &m_lightingUBO);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_lightingUBO);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(lightingData), &lightingData, GL_STATIC_DRAW);
+		glBindBufferBase(GL_UNIFORM_BUFFER, g_LightingBlockBinding, m_lightingUBO);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		m_bUseLightingBuffer = true;
+		return;
+	}
+
+	// otherwise send the same values through the individually named
+	// uniforms from the unmodified shader code
+	std::cout << "Lighting block not found in shader, using named light uniforms" << std::endl;
+
+	m_pShaderManager->setVec3Value("ambientLight", glm::vec3(lightingData.ambientLight));
+
+	m_pShaderManager->setVec3Value("directionalLight.direction", glm::vec3(lightingData.directionalDirectionActive));
+	m_pShaderManager->setVec3Value("directionalLight.ambient", glm::vec3(lightingData.directionalAmbient));
+	m_pShaderManager->setVec3Value("directionalLight.diffuse", glm::vec3(lightingData.directionalDiffuse));
+	m_pShaderManager->setVec3Value("directionalLight.specular", glm::vec3(lightingData.directionalSpecular));
+	m_pShaderManager->setBoolValue("directionalLight.bActive", true);
 
-	// Point Light 1: Above Coffee Mug, angled toward it
-	m_pShaderManager->setVec3Value("pointLights[0].position", glm::vec3(-11.0f, 8.0f, 6.0f)); // Offset to point toward the mug
-	m_pShaderManager->setVec3Value("pointLights[0].ambient", glm::vec3(0.05f, 0.05f, 0.05f));
-	m_pShaderManager->setVec3Value("pointLights[0].diffuse", glm::vec3(0.8f, 0.8f, 0.8f));
-	m_pShaderManager->setVec3Value("pointLights[0].specular", glm::vec3(1.0f, 1.0f, 1.0f));
-	m_pShaderManager->setFloatValue("pointLights[0].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[0].linear", 0.14f);
-	m_pShaderManager->setFloatValue("pointLights[0].quadratic", 0.07f);
-	m_pShaderManager->setBoolValue("pointLights[0].bActive", true);
-
-	// Point Light 2: Above Box Item, angled toward it
-	m_pShaderManager->setVec3Value("pointLights[1].position", glm::vec3(-6.0f, 8.0f, 6.5f)); // Offset to point toward the box
-	m_pShaderManager->setVec3Value("pointLights[1].ambient", glm::vec3(0.05f, 0.05f, 0.05f));
-	m_pShaderManager->setVec3Value("pointLights[1].diffuse", glm::vec3(0.8f, 0.8f, 0.8f));
-	m_pShaderManager->setVec3Value("pointLights[1].specular", glm::vec3(1.0f, 1.0f, 1.0f));
-	m_pShaderManager->setFloatValue("pointLights[1].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[1].linear", 0.14f);
-	m_pShaderManager->setFloatValue("pointLights[1].quadratic", 0.07f);
-	m_pShaderManager->setBoolValue("pointLights[1].bActive", true);
-
-	// Point Light 3: Above Trashcan, angled toward it
-	m_pShaderManager->setVec3Value("pointLights[2].position", glm::vec3(3.0f, 8.0f, 4.0f)); // Offset to point toward the trashcan
-	m_pShaderManager->setVec3Value("pointLights[2].ambient", glm::vec3(0.05f, 0.05f, 0.05f));
-	m_pShaderManager->setVec3Value("pointLights[2].diffuse", glm::vec3(0.8f, 0.8f, 0.8f));
-	m_pShaderManager->setVec3Value("pointLights[2].specular", glm::vec3(1.0f, 1.0f, 1.0f));
-	m_pShaderManager->setFloatValue("pointLights[2].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[2].linear", 0.14f);
-	m_pShaderManager->setFloatValue("pointLights[2].quadratic", 0.07f);
-	m_pShaderManager->setBoolValue("pointLights[2].bActive", true);
-
-	// Point Light 4: Above Wooden Plank, angled toward it
-	m_pShaderManager->setVec3Value("pointLights[3].position", glm::vec3(9.0f, 8.0f, 6.0f)); // Offset to point toward the plank
-	m_pShaderManager->setVec3Value("pointLights[3].ambient", glm::vec3(0.05f, 0.05f, 0.05f));
-	m_pShaderManager->setVec3Value("pointLights[3].diffuse", glm::vec3(0.8f, 0.8f, 0.8f));
-	m_pShaderManager->setVec3Value("pointLights[3].specular", glm::vec3(1.0f, 1.0f, 1.0f));
-	m_pShaderManager->setFloatValue("pointLights[3].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[3].linear", 0.14f);
-	m_pShaderManager->setFloatValue("pointLights[3].quadratic", 0.07f);
-	m_pShaderManager->setBoolValue("pointLights[3].bActive", true);
+	m_pShaderManager->setVec3Value("spotLight.position", glm::vec3(lightingData.spotPositionActive));
+	m_pShaderManager->setVec3Value("spotLight.direction", glm::vec3(lightingData.spotDirection));
+	m_pShaderManager->setVec3Value("spotLight.ambient", glm::vec3(lightingData.spotAmbient));
+	m_pShaderManager->setVec3Value("spotLight.diffuse", glm::vec3(lightingData.spotDiffuse));
+	m_pShaderManager->setVec3Value("spotLight.specular", glm::vec3(lightingData.spotSpecular));
+	m_pShaderManager->setFloatValue("spotLight.cutOff", lightingData.spotParams.x);
+	m_pShaderManager->setFloatValue("spotLight.outerCutOff", lightingData.spotParams.y);
+	m_pShaderManager->setFloatValue("spotLight.constant", lightingData.spotParams.z);
+	m_pShaderManager->setFloatValue("spotLight.linear", lightingData.spotParams.w);
+	m_pShaderManager->setFloatValue("spotLight.quadratic", lightingData.spotParams2.x);
+	m_pShaderManager->setBoolValue("spotLight.bActive", true);
 
+	for (int i = 0; i < 4; i++)
+	{
+		std::string lightName = "pointLights[" + std::to_string(i) + "]";
+		m_pShaderManager->setVec3Value(lightName + ".position", glm::vec3(lightingData.pointLights[i].positionActive));
+		m_pShaderManager->setVec3Value(lightName + ".ambient", glm::vec3(lightingData.pointLights[i].ambient));
+		m_pShaderManager->setVec3Value(lightName + ".diffuse", glm::vec3(lightingData.pointLights[i].diffuse));
+		m_pShaderManager->setVec3Value(lightName + ".specular", glm::vec3(lightingData.pointLights[i].specular));
+		m_pShaderManager->setFloatValue(lightName + ".constant", lightingData.pointLights[i].attenuation.x);
+		m_pShaderManager->setFloatValue(lightName + ".linear", lightingData.pointLights[i].attenuation.y);
+		m_pShaderManager->setFloatValue(lightName + ".quadratic", lightingData.pointLights[i].attenuation.z);
+		m_pShaderManager->setBoolValue(lightName + ".bActive", true);
+	}
 }
 
 void SceneManager::LoadSceneTextures()
@@ -494,13 +2698,14 @@ void SceneManager::LoadSceneTextures()
 	/*** 16 textures can be loaded per scene. Refer to the code in   ***/
 	/*** the OpenGL Sample for help.                                 ***/
 
-	bool bReturn = false;
-	bReturn = CreateGLTexture("textures/black.jpg", "mugbase"); //Flat black color texture
-	bReturn = CreateGLTexture("textures/teachflag.jpg", "flag"); //Black background with imposed image for mugh
-	bReturn = CreateGLTexture("textures/Wood066_2K-JPG_Color.jpg", "table"); //Wood plank to replicate table top 
-	bReturn = CreateGLTexture("textures/Wood048_1K-JPG_Color.jpg", "plank"); //Base wood texture
-	bReturn = CreateGLTexture("textures/Plastic010_1K-JPG_Color.jpg", "plastic"); //Light blue plastic appearing texture
-	bReturn = CreateGLTexture("textures/office.jpg", "office"); //Black background with imposed image to replicate desk decour
+	// keep the returned handles so the Render* methods can set the
+	// textures without a tag lookup per object
+	m_mugBaseTextureHandle = CreateGLTextureAsync("textures/black.jpg", "mugbase"); //Flat black color texture
+	m_flagTextureHandle = CreateGLTextureAsync("textures/teachflag.jpg", "flag"); //Black background with imposed image for mugh
+	m_tableTextureHandle = CreateGLTextureAsync("textures/Wood066_2K-JPG_Color.jpg", "table"); //Wood plank to replicate table top
+	m_plankTextureHandle = CreateGLTextureAsync("textures/Wood048_1K-JPG_Color.jpg", "plank"); //Base wood texture
+	m_plasticTextureHandle = CreateGLTextureAsync("textures/Plastic010_1K-JPG_Color.jpg", "plastic"); //Light blue plastic appearing texture
+	m_officeTextureHandle = CreateGLTextureAsync("textures/office.jpg", "office"); //Black background with imposed image to replicate desk decour
 
 	// after the texture image data is loaded into memory, the
 	// loaded textures need to be bound to texture slots - there
@@ -508,6 +2713,163 @@ void SceneManager::LoadSceneTextures()
 	BindGLTextures();
 }
 
+/***********************************************************
+ *  LoadBakedScene()
+ *
+ *  This method fills the draw list from the passed in baked
+ *  scene file - the whole record array is pulled in with a
+ *  single read.  Returns false when no usable baked scene
+ *  file exists, in which case the authored Render* methods
+ *  record the scene as before.
+ ***********************************************************/
+bool SceneManager::LoadBakedScene(const char* filename)
+{
+	BAKED_SCENE_HEADER header;
+	std::vector<BAKED_SCENE_RECORD> records;
+
+	FILE* pSceneFile = fopen(filename, "rb");
+	if (NULL == pSceneFile)
+	{
+		return false;
+	}
+
+	if (fread(&header, sizeof(header), 1, pSceneFile) != 1 ||
+		memcmp(header.magic, g_BakedSceneMagic, sizeof(g_BakedSceneMagic)) != 0 ||
+		header.version != g_BakedSceneVersion ||
+		header.recordCount < 1)
+	{
+		fclose(pSceneFile);
+		return false;
+	}
+
+	records.resize(header.recordCount);
+	if (fread(records.data(), sizeof(BAKED_SCENE_RECORD),
+		header.recordCount, pSceneFile) != (size_t)header.recordCount)
+	{
+		fclose(pSceneFile);
+		return false;
+	}
+	fclose(pSceneFile);
+
+	// validate every record before converting - a stale baked scene
+	// written against a different texture or material registration
+	// list would otherwise carry handles that index past the counts
+	// registered this launch
+	for (int i = 0; i < header.recordCount; i++)
+	{
+		const BAKED_SCENE_RECORD& record = records[i];
+
+		if ((record.meshID < (int)drawBox) ||
+			(record.meshID > (int)drawTorusLOD) ||
+			(record.boxSide < (int)ShapeMeshes::front) ||
+			(record.boxSide > (int)ShapeMeshes::bottom) ||
+			(record.textureHandle < -1) ||
+			(record.textureHandle >= m_loadedTextures) ||
+			((record.bUseTexture != 0) && (record.textureHandle < 0)) ||
+			(record.materialHandle < -1) ||
+			(record.materialHandle >= (int)m_objectMaterials.size()))
+		{
+			std::cout << "Baked scene file does not match the registered "
+				<< "meshes/textures/materials, re-recording the scene : "
+				<< filename << std::endl;
+			return false;
+		}
+	}
+
+	// convert the flat records into draw items - the texture and
+	// material handles are registration order indexes, which the
+	// load-time code assigns deterministically every launch
+	m_drawList.clear();
+	m_drawList.reserve(header.recordCount);
+	for (int i = 0; i < header.recordCount; i++)
+	{
+		const BAKED_SCENE_RECORD& record = records[i];
+		DRAW_ITEM item;
+
+		item.meshID = (DrawMeshID)record.meshID;
+		item.boxSide = (ShapeMeshes::BoxSide)record.boxSide;
+		item.bDrawTop = (record.bDrawTop != 0);
+		item.bDrawBottom = (record.bDrawBottom != 0);
+		item.bDrawSides = (record.bDrawSides != 0);
+		memcpy(&item.modelMatrix, record.modelMatrix, sizeof(record.modelMatrix));
+		memcpy(&item.positionXYZ, record.positionXYZ, sizeof(record.positionXYZ));
+		item.boundingRadius = record.boundingRadius;
+		memcpy(&item.color, record.color, sizeof(record.color));
+		memcpy(&item.uvScale, record.uvScale, sizeof(record.uvScale));
+		item.bUseTexture = (record.bUseTexture != 0);
+		item.textureHandle = record.textureHandle;
+		item.materialHandle = record.materialHandle;
+		item.groupID = record.groupID;
+
+		m_drawList.push_back(item);
+	}
+
+	std::cout << "Loaded baked scene : " << filename
+		<< " (" << header.recordCount << " draws)" << std::endl;
+
+	return true;
+}
+
+/***********************************************************
+ *  SaveBakedScene()
+ *
+ *  This method exports the recorded draw list into the
+ *  passed in baked scene file so later launches can load
+ *  the scene without running the authored Render* methods.
+ ***********************************************************/
+void SceneManager::SaveBakedScene(const char* filename)
+{
+	BAKED_SCENE_HEADER header;
+	std::vector<BAKED_SCENE_RECORD> records;
+
+	if (m_drawList.empty() == true)
+	{
+		return;
+	}
+
+	records.reserve(m_drawList.size());
+	for (int i = 0; i < (int)m_drawList.size(); i++)
+	{
+		const DRAW_ITEM& item = m_drawList[i];
+		BAKED_SCENE_RECORD record;
+
+		record.meshID = (int)item.meshID;
+		record.boxSide = (int)item.boxSide;
+		record.bDrawTop = (item.bDrawTop == true) ? 1 : 0;
+		record.bDrawBottom = (item.bDrawBottom == true) ? 1 : 0;
+		record.bDrawSides = (item.bDrawSides == true) ? 1 : 0;
+		memcpy(record.modelMatrix, &item.modelMatrix, sizeof(record.modelMatrix));
+		memcpy(record.positionXYZ, &item.positionXYZ, sizeof(record.positionXYZ));
+		record.boundingRadius = item.boundingRadius;
+		memcpy(record.color, &item.color, sizeof(record.color));
+		memcpy(record.uvScale, &item.uvScale, sizeof(record.uvScale));
+		record.bUseTexture = (item.bUseTexture == true) ? 1 : 0;
+		record.textureHandle = item.textureHandle;
+		record.materialHandle = item.materialHandle;
+		record.groupID = item.groupID;
+
+		records.push_back(record);
+	}
+
+	FILE* pSceneFile = fopen(filename, "wb");
+	if (NULL == pSceneFile)
+	{
+		std::cout << "Could not write baked scene file : " << filename << std::endl;
+		return;
+	}
+
+	memcpy(header.magic, g_BakedSceneMagic, sizeof(g_BakedSceneMagic));
+	header.version = g_BakedSceneVersion;
+	header.recordCount = (int)records.size();
+
+	fwrite(&header, sizeof(header), 1, pSceneFile);
+	fwrite(records.data(), sizeof(BAKED_SCENE_RECORD), records.size(), pSceneFile);
+	fclose(pSceneFile);
+
+	std::cout << "Baked scene written : " << filename
+		<< " (" << header.recordCount << " draws)" << std::endl;
+}
+
 /***********************************************************
  *  PrepareScene()
  *
@@ -521,18 +2883,39 @@ void SceneManager::PrepareScene()
 	// only one instance of a particular mesh needs to be
 	// loaded in memory no matter how many times it is drawn
 	// in the rendered 3D scene
+	// start computing the procedural shape mesh data on worker
+	// threads - it runs while the rest of the scene prep executes
+	// and the Load*Mesh calls below then only upload
+	m_basicMeshes->PregenerateMeshData();
+
 	// define the materials for objects in the scene
 	DefineObjectMaterials();
+	// upload the defined materials into the material uniform block
+	InitializeMaterialBuffer();
 	// add and define the light sources for the scene
 	SetupSceneLights();
 	// load the textures for the 3D scene
 	LoadSceneTextures();
+	// create the ring buffer for the per-object model matrices
+	InitializeTransformBuffer();
 
 	m_basicMeshes->LoadPlaneMesh();
 	m_basicMeshes->LoadCylinderMesh();
 	m_basicMeshes->LoadTorusMesh();
 	m_basicMeshes->LoadBoxMesh();
 	m_basicMeshes->LoadSphereMesh();
+
+	// merge the loaded meshes into one shared vertex/index buffer so
+	// the render loop does not switch vertex arrays between shapes
+	m_basicMeshes->ConsolidateMeshBuffers();
+
+	// the mesh building scratch memory is no longer needed
+	m_basicMeshes->ReleaseScratchBuffers();
+
+	// when a baked scene file is present its records fill the draw
+	// list directly and the record pass of the first rendered frame
+	// is skipped
+	LoadBakedScene(g_BakedSceneFilename);
 }
 
 //Table Top Creates Surface for objects and called in RenderScence
@@ -570,11 +2953,11 @@ void SceneManager::RenderTableTop() {
 		ZrotationDegrees,
 		positionXYZ);
 
-	SetShaderTexture("table"); //provide wood like texture to replicate image
-	SetShaderMaterial("wood"); //texture reflects wood in a similar way it would in real life
+	SetShaderTexture(m_tableTextureHandle); //provide wood like texture to replicate image
+	SetShaderMaterial(m_woodMaterialHandle); //texture reflects wood in a similar way it would in real life
 
 	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
+	DrawSceneBoxMesh();
 	/****************************************************************/
 
 }
@@ -604,17 +2987,17 @@ void SceneManager::RenderMug() {
 
 	// set the color for the next draw command
 	// Set the texture for the coffee mug
-	SetShaderTexture("flag");
+	SetShaderTexture(m_flagTextureHandle);
 	// Set UV scale for tiling
 	SetTextureUVScale(0.5f, 0.5f);
-	SetShaderMaterial("wood");
-	m_basicMeshes->DrawCylinderMesh(false, false, true); //place texture on side of cylinder
+	SetShaderMaterial(m_woodMaterialHandle);
+	DrawSceneCylinderMesh(false, false, true); //place texture on side of cylinder
 
-	SetShaderTexture("mugbase");
+	SetShaderTexture(m_mugBaseTextureHandle);
 	// Set UV scale for tiling
 	SetTextureUVScale(0.5f, 0.5f);
-	SetShaderMaterial("wood");
-	m_basicMeshes->DrawCylinderMesh(false, true, false); //place texture on the bottom of cylinder leaving the top open
+	SetShaderMaterial(m_woodMaterialHandle);
+	DrawSceneCylinderMesh(false, true, false); //place texture on the bottom of cylinder leaving the top open
 
 	//Mug Handle
 	// set the XYZ scale for the mesh
@@ -637,10 +3020,11 @@ void SceneManager::RenderMug() {
 		positionXYZ);
 
 	// set the color for the next draw command
-	SetShaderTexture("mugbase");
-	SetShaderMaterial("wood");
-	// draw the filled cylinder shape
-	m_basicMeshes->DrawTorusMesh();
+	SetShaderTexture(m_mugBaseTextureHandle);
+	SetShaderMaterial(m_woodMaterialHandle);
+	// draw the filled torus shape - the handle is small on screen
+	// from a distance so the draw picks a matching level-of-detail
+	DrawSceneTorusMeshLOD();
 	/****************************************************************/
 
 }
@@ -673,15 +3057,15 @@ void SceneManager::RenderOffieDeskItem() {
 		positionXYZ);
 
 	// set the color for the next draw command
-	SetShaderTexture("office");
+	SetShaderTexture(m_officeTextureHandle);
 	SetTextureUVScale(1.0f, 1.0f);
-	SetShaderMaterial("wood");
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::front); //Place office image on front of item leaving the sides blank
+	SetShaderMaterial(m_woodMaterialHandle);
+	DrawSceneBoxMeshSide(ShapeMeshes::front); //Place office image on front of item leaving the sides blank
 
-	SetShaderTexture("mugbase");
+	SetShaderTexture(m_mugBaseTextureHandle);
 	SetTextureUVScale(1.0f, 1.0f);
-	SetShaderMaterial("wood");
-	m_basicMeshes->DrawBoxMesh(); //Wrap the rest of the object in a flat black texture
+	SetShaderMaterial(m_woodMaterialHandle);
+	DrawSceneBoxMesh(); //Wrap the rest of the object in a flat black texture
 	/****************************************************************/
 
 }
@@ -715,10 +3099,10 @@ void SceneManager::RenderTrashCan() {
 	// set the color for the next draw command
 	// draw the filled sphere shape
 	//Wrap half sphere base to give rounded bottom appearance
-	SetShaderTexture("plastic");
+	SetShaderTexture(m_plasticTextureHandle);
 	SetTextureUVScale(1.0f, 1.0f);
-	SetShaderMaterial("plastic");
-	m_basicMeshes->DrawHalfSphereMesh();
+	SetShaderMaterial(m_plasticMaterialHandle);
+	DrawSceneHalfSphereMesh();
 	/****************************************************************/
 
 
@@ -749,11 +3133,11 @@ void SceneManager::RenderTrashCan() {
 
 	// set the color for the next draw command
 	//Wrap the side of the cylinder in a plastic like texture appearance and color
-	SetShaderTexture("plastic");
+	SetShaderTexture(m_plasticTextureHandle);
 	SetTextureUVScale(1.0f, 1.0f);
-	SetShaderMaterial("plastic");
+	SetShaderMaterial(m_plasticMaterialHandle);
 	// draw the filled cylinder shape
-	m_basicMeshes->DrawCylinderMesh(false, false, true); //Only creates side of the cylinder to show sides of trashcan and leave an open top
+	DrawSceneCylinderMesh(false, false, true); //Only creates side of the cylinder to show sides of trashcan and leave an open top
 	/******************************************************************/
 
 }
@@ -789,11 +3173,11 @@ void SceneManager::RenderScrapWood() {
 	// set the color for the next draw command
 	//SetShaderColor(0.8f, 0.5f, 0.3f, 1.0f);
 	//Wraps all sides of the plank of wood like in real life
-	SetShaderTexture("plank");
+	SetShaderTexture(m_plankTextureHandle);
 	SetTextureUVScale(1.0f, 1.0f);
-	SetShaderMaterial("wood");
+	SetShaderMaterial(m_woodMaterialHandle);
 	// draw the filled cylinder shape
-	m_basicMeshes->DrawBoxMesh();
+	DrawSceneBoxMesh();
 	/****************************************************************/
 
 }
@@ -805,11 +3189,98 @@ void SceneManager::RenderScrapWood() {
  ***********************************************************/
 void SceneManager::RenderScene()
 {
-	RenderTableTop();
-	RenderMug();
-	RenderOffieDeskItem();
-	RenderTrashCan();
-	RenderScrapWood();
+	// the instrumentation counters restart every frame
+	m_frameDrawCalls = 0;
+	m_frameStateChanges = 0;
+	m_frameUniformUpdates = 0;
+
+	// swap in any texture images whose decode has finished
+	FrameProfiler::BeginSection("TextureUploads");
+	PushDebugGroup("TextureUploads");
+	ProcessPendingTextureUploads();
+	PopDebugGroup();
+	FrameProfiler::EndSection();
+
+	// move to the ring buffer region for this frame
+	BeginTransformFrame();
+
+	if (m_bDrawListRecorded == false)
+	{
+		// when a baked scene was loaded during PrepareScene() the draw
+		// list is already filled and the record pass is skipped
+		if (m_drawList.empty() == true)
+		{
+			// the scene is static, so the authored Render* methods only
+			// run once in record mode to capture the draw items - the
+			// sorted list is replayed every frame afterwards.  Each method
+			// records into its own draw group for occlusion culling
+			m_bRecordingDraws = true;
+			m_currentDrawItem.groupID = 0;
+			PushDebugGroup("RenderTableTop");
+			RenderTableTop();
+			PopDebugGroup();
+			m_currentDrawItem.groupID = 1;
+			PushDebugGroup("RenderMug");
+			RenderMug();
+			PopDebugGroup();
+			m_currentDrawItem.groupID = 2;
+			PushDebugGroup("RenderOffieDeskItem");
+			RenderOffieDeskItem();
+			PopDebugGroup();
+			m_currentDrawItem.groupID = 3;
+			PushDebugGroup("RenderTrashCan");
+			RenderTrashCan();
+			PopDebugGroup();
+			m_currentDrawItem.groupID = 4;
+			PushDebugGroup("RenderScrapWood");
+			RenderScrapWood();
+			PopDebugGroup();
+			m_bRecordingDraws = false;
+
+			// export the recorded scene so later launches load it from
+			// the baked file instead
+			SaveBakedScene(g_BakedSceneFilename);
+		}
+
+		SortDrawList();
+		BuildDrawGroups();
+		BuildIndirectBuckets();
+		m_bDrawListRecorded = true;
+	}
+
+	if (m_bUseIndirectDraw == true)
+	{
+		// the baked command buckets replace the replay loop - the
+		// per-group occlusion machinery is skipped since it cannot
+		// remove commands from a baked buffer
+		FrameProfiler::BeginSection("DrawSubmit");
+		PushDebugGroup("DrawSubmit");
+		SubmitIndirectDraws();
+		PopDebugGroup();
+		FrameProfiler::EndSection();
+	}
+	else
+	{
+		// pick up the occlusion query results of the previous frame
+		UpdateGroupVisibility();
+
+		FrameProfiler::BeginSection("DrawSubmit");
+		PushDebugGroup("DrawSubmit");
+		ReplayDrawList();
+		PopDebugGroup();
+		FrameProfiler::EndSection();
+
+		// draw the bounding box proxies of the groups inside occlusion
+		// queries - the results are read back next frame
+		FrameProfiler::BeginSection("OcclusionQueries");
+		PushDebugGroup("OcclusionQueries");
+		IssueOcclusionQueries();
+		PopDebugGroup();
+		FrameProfiler::EndSection();
+	}
+
+	// fence the ring buffer region that was just filled
+	EndTransformFrame();
 }
 
 
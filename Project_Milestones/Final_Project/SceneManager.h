@@ -12,6 +12,7 @@
 #include "ShaderManager.h"
 #include "ShapeMeshes.h"
 
+#include <future>
 #include <string>
 #include <vector>
 
@@ -43,20 +44,141 @@ public:
 		std::string tag;
 	};
 
+	// available texture filtering quality levels - bilinear matches
+	// the original fixed GL_LINEAR behavior, trilinear samples across
+	// the mip chain, and anisotropic additionally applies the maximum
+	// supported anisotropy for surfaces viewed at grazing angles
+	enum TextureFilterQuality
+	{
+		filterBilinear,
+		filterTrilinear,
+		filterAnisotropic
+	};
+
+	struct PENDING_TEXTURE
+	{
+		std::string filename;
+		int slot;
+		int width;
+		int height;
+		int colorChannels;
+		int levelCount;
+		unsigned char* pImageData;
+		// baked mip chain read from the on-disk texture cache - when
+		// this is filled in no decode ran and pImageData stays NULL
+		bool bFromCache;
+		std::vector<unsigned char> cacheData;
+	};
+
 private:
 	// pointer to shader manager object
 	ShaderManager* m_pShaderManager;
 	// pointer to basic shapes object
 	ShapeMeshes* m_basicMeshes;
+	// cached handles for the uniforms that are updated for every
+	// object in the scene - resolved once in the constructor
+	ShaderManager::UniformHandle m_hModelMatrix;
+	ShaderManager::UniformHandle m_hColorValue;
+	ShaderManager::UniformHandle m_hUseTexture;
+	ShaderManager::UniformHandle m_hTextureValue;
+	ShaderManager::UniformHandle m_hUVscale;
+	ShaderManager::UniformHandle m_hMaterialDiffuseColor;
+	ShaderManager::UniformHandle m_hMaterialSpecularColor;
+	ShaderManager::UniformHandle m_hMaterialShininess;
+
+	// persistently mapped ring buffer holding the per-object model
+	// matrices - filled by SetTransformations() and consumed by the
+	// shader through the TransformBlock uniform block
+	bool m_bUseTransformBuffer;
+	GLuint m_transformUBO;
+	GLubyte* m_pTransformBufferData;
+	GLint m_transformSlotSize;
+	int m_transformSlotsPerFrame;
+	int m_transformFrameIndex;
+	int m_transformSlotIndex;
+	GLsync m_transformFrameSync[3];
+
+	// uniform block buffers for the static lighting setup and the
+	// defined object materials - uploaded once during scene prep
+	bool m_bUseLightingBuffer;
+	bool m_bUseMaterialBuffer;
+	GLuint m_lightingUBO;
+	GLuint m_materialUBO;
+	ShaderManager::UniformHandle m_hMaterialIndex;
+
+	// upload the defined object materials into a uniform block
+	void InitializeMaterialBuffer();
+	// free the lighting and material uniform block buffers
+	void DestroyLightingBuffers();
+
+	// create the persistently mapped transform ring buffer
+	void InitializeTransformBuffer();
+	// free the transform ring buffer
+	void DestroyTransformBuffer();
+	// advance the ring buffer to the region for the next frame
+	void BeginTransformFrame();
+	// fence the region that was filled during the current frame
+	void EndTransformFrame();
 	// total number of loaded textures
 	int m_loadedTextures;
 	// loaded textures info
-	TEXTURE_INFO m_textureIDs[16];
+	std::vector<TEXTURE_INFO> m_textureIDs;
+
+	// texture array built from the loaded textures of one shared size -
+	// the layers replace the per-texture binding slots, so any number
+	// of textures can be drawn without switching texture units
+	struct TEXTURE_ARRAY_INFO
+	{
+		GLuint ID;
+		int width;
+		int height;
+		int colorChannels;
+		int textureUnit;
+	};
+	// only used when the shader declares the array sampler - otherwise
+	// the per-texture 2D bindings above remain in effect
+	bool m_bUseTextureArrays;
+	bool m_bTextureArraysBuilt;
+	std::vector<TEXTURE_ARRAY_INFO> m_textureArrays;
+	// per loaded texture - which array holds it and in which layer
+	std::vector<int> m_textureArrayIndex;
+	std::vector<int> m_textureLayer;
+	// finished decodes held back until every texture is available and
+	// the arrays can be grouped by size
+	std::vector<PENDING_TEXTURE> m_decodedTextures;
+	ShaderManager::UniformHandle m_hTextureArray;
+	ShaderManager::UniformHandle m_hTextureLayer;
 	// defined object materials
 	std::vector<OBJECT_MATERIAL> m_objectMaterials;
 
-	// load texture images and convert to OpenGL texture data
-	bool CreateGLTexture(const char* filename, std::string tag);
+	// texture image decodes running on worker threads - each one is
+	// uploaded into its placeholder texture once the decode finishes
+	std::vector<std::future<PENDING_TEXTURE>> m_pendingTextures;
+	// pixel buffer object that stages the decoded pixels for upload
+	GLuint m_texturePBO;
+
+	// load texture images and convert to OpenGL texture data - returns
+	// the integer handle of the registered texture, or -1 on failure
+	int CreateGLTexture(const char* filename, std::string tag,
+		TextureFilterQuality filterQuality = filterAnisotropic);
+	// register a placeholder texture for the tag and start decoding
+	// the image file on a worker thread - returns the integer handle
+	// of the registered texture
+	int CreateGLTextureAsync(const char* filename, std::string tag,
+		TextureFilterQuality filterQuality = filterAnisotropic);
+	// set the filtering parameters of the currently bound texture
+	// for the passed in quality level
+	void ApplyTextureFilter(GLenum target, TextureFilterQuality filterQuality);
+	// group the finished texture decodes by size into texture arrays
+	// and bind the arrays once
+	void BuildTextureArrays();
+	// upload any texture decodes that have finished - called once
+	// per frame from RenderScene()
+	void ProcessPendingTextureUploads();
+	// bake the mip chain of the currently bound texture into a cache
+	// file next to the source image
+	void SaveTextureCache(const std::string& filename, GLenum format,
+		int width, int height, int colorChannels);
 	// bind loaded OpenGL textures to slots in memory
 	void BindGLTextures();
 	// free the loaded OpenGL textures
@@ -66,6 +188,178 @@ private:
 	int FindTextureSlot(std::string tag);
 	// find a defined material by tag
 	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
+	// register an object material - returns its integer handle
+	int AddObjectMaterial(const OBJECT_MATERIAL& material);
+
+	// integer handles for the textures and materials used by the
+	// Render* methods - returned at registration time so the
+	// per-object draw path does not compare tag strings
+	int m_mugBaseTextureHandle;
+	int m_flagTextureHandle;
+	int m_tableTextureHandle;
+	int m_plankTextureHandle;
+	int m_plasticTextureHandle;
+	int m_officeTextureHandle;
+	int m_woodMaterialHandle;
+	int m_plasticMaterialHandle;
+
+	// identifies which shape mesh a recorded draw item renders
+	enum DrawMeshID
+	{
+		drawBox,
+		drawBoxSide,
+		drawCylinder,
+		drawHalfSphere,
+		drawTorusLOD
+	};
+
+	// one recorded draw of the static scene - the complete shader
+	// state for the object is captured so the list can be replayed
+	// in any order
+	struct DRAW_ITEM
+	{
+		DrawMeshID meshID;
+		ShapeMeshes::BoxSide boxSide;
+		bool bDrawTop;
+		bool bDrawBottom;
+		bool bDrawSides;
+		glm::mat4 modelMatrix;
+		glm::vec3 positionXYZ;		// for distance based LOD selection
+		float boundingRadius;		// for view-frustum visibility tests
+		glm::vec4 color;
+		glm::vec2 uvScale;
+		bool bUseTexture;
+		int textureHandle;
+		int materialHandle;
+		int groupID;			// index of the draw group the item belongs to
+	};
+
+	// one group of recorded draws - matches one authored Render*
+	// method.  The group's bounding box is drawn as an occlusion query
+	// proxy after the real draws each frame, and the result read back
+	// one frame later decides whether the group is drawn at all
+	struct DRAW_GROUP
+	{
+		glm::vec3 boundsMin;
+		glm::vec3 boundsMax;
+		GLuint occlusionQuery[2];	// double buffered for one-frame latency
+		bool bQueryIssued[2];
+		bool bVisible;
+	};
+	std::vector<DRAW_GROUP> m_drawGroups;
+	// selects which of the double buffered queries is written this
+	// frame while the other one is read
+	int m_occlusionFrameParity;
+
+	// indirect submission path for the static scene - the sorted draw
+	// list is baked into GL_DRAW_INDIRECT_BUFFER commands bucketed by
+	// shader state, and each bucket is submitted with one
+	// glMultiDrawElementsIndirect call.  Only used when the hardware
+	// and the shader support it
+	struct INDIRECT_BUCKET
+	{
+		bool bUseTexture;
+		int textureHandle;
+		glm::vec4 color;
+		glm::vec2 uvScale;
+		int materialHandle;
+		GLsizeiptr commandOffset;	// byte offset into the indirect buffer
+		GLsizei commandCount;
+		GLintptr matrixOffset;		// byte offset into the matrix block
+	};
+	bool m_bUseIndirectDraw;
+	GLuint m_indirectBuffer;
+	GLuint m_indirectMatrixUBO;
+	ShaderManager::UniformHandle m_hIndirectDrawFlag;
+	std::vector<INDIRECT_BUCKET> m_indirectBuckets;
+	// recorded items that cannot be expressed as indexed ranges and
+	// are still drawn through the replay path after the buckets
+	std::vector<int> m_indirectLeftoverItems;
+
+	// bake the recorded draw list into indirect command buckets
+	void BuildIndirectBuckets();
+	// submit the baked buckets and draw the leftover items
+	void SubmitIndirectDraws();
+
+	// per-frame draw ordering - when enabled the visible items are
+	// replayed front to back so nearer surfaces are laid down first
+	// and covered fragments fail the depth test early
+	bool m_bSortFrontToBack;
+	// optional depth-only pass before the lit pass - lays down the
+	// final depth buffer first so the lighting shader only runs on
+	// the surfaces that remain visible
+	bool m_bDepthPrePass;
+	// replay order of the draw list indices for the current frame
+	std::vector<int> m_drawOrder;
+
+	// test one draw item against the frustum planes and the group
+	// occlusion results
+	bool IsItemVisible(const glm::vec4 planes[6], const DRAW_ITEM& item);
+
+	// collect the bounding box of each recorded draw group
+	void BuildDrawGroups();
+	// read back the occlusion query results of the previous frame
+	void UpdateGroupVisibility();
+	// draw the bounding box proxy of each group inside an occlusion
+	// query, with color and depth writes disabled
+	void IssueOcclusionQueries();
+
+	// recorded draw list for the static scene - filled by running the
+	// authored Render* methods once in record mode, sorted by texture,
+	// material, and mesh, then replayed every frame afterwards
+	bool m_bRecordingDraws;
+	bool m_bDrawListRecorded;
+	std::vector<DRAW_ITEM> m_drawList;
+	// shader state being accumulated for the next recorded draw
+	DRAW_ITEM m_currentDrawItem;
+
+	// last values sent to the shader for the per-object parameters -
+	// used for silently dropping redundant uniform updates when
+	// consecutive objects share the same values
+	glm::vec4 m_lastColor;
+	glm::vec2 m_lastUVScale;
+	int m_lastUseTexture;		// -1 until the first update
+	int m_lastTextureSlot;
+	int m_lastTextureLayer;
+	int m_lastMaterialHandle;
+
+	// per-frame instrumentation counters, reset at the start of
+	// every RenderScene() call
+	int m_frameDrawCalls;
+	int m_frameStateChanges;
+	int m_frameUniformUpdates;
+
+	// upload the passed in model matrix for the next draw
+	void ApplyModelMatrix(const glm::mat4& modelMatrix);
+	// append the accumulated draw item in record mode, or issue its
+	// draw immediately otherwise
+	void CommitDrawItem();
+	// issue the mesh draw of the passed in item
+	void DrawItemMesh(const DRAW_ITEM& item);
+	// sort the recorded draw list to minimize GL state transitions
+	void SortDrawList();
+	// extract the six view-frustum planes from the current combined
+	// projection * view matrix
+	void ExtractFrustumPlanes(glm::vec4 planes[6]);
+	// test the bounding sphere of a draw item against the planes
+	bool IsSphereVisible(const glm::vec4 planes[6],
+		const glm::vec3& center, float radius);
+	// apply the state of each recorded item and issue its draw
+	void ReplayDrawList();
+
+	// fill the draw list from the baked scene file - returns false
+	// when no usable baked scene file exists
+	bool LoadBakedScene(const char* filename);
+	// export the recorded draw list into the baked scene file
+	void SaveBakedScene(const char* filename);
+
+	// draw dispatch used by the Render* methods - in record mode these
+	// append a draw item instead of drawing immediately
+	void DrawSceneBoxMesh();
+	void DrawSceneBoxMeshSide(ShapeMeshes::BoxSide side);
+	void DrawSceneCylinderMesh(bool bDrawTop, bool bDrawBottom, bool bDrawSides);
+	void DrawSceneHalfSphereMesh();
+	void DrawSceneTorusMeshLOD();
 
 	// set the transformation values 
 	// into the transform buffer
@@ -83,17 +377,23 @@ private:
 		float blueColorValue,
 		float alphaValue);
 
-	// set the texture data into the shader
+	// set the texture data into the shader - the tag overload is a
+	// load-time convenience, the handle overload is the draw path
 	void SetShaderTexture(
 		std::string textureTag);
+	void SetShaderTexture(
+		int textureHandle);
 
 	// set the UV scale for the texture mapping
 	void SetTextureUVScale(
 		float u, float v);
 
-	// set the object material into the shader
+	// set the object material into the shader - the tag overload is a
+	// load-time convenience, the handle overload is the draw path
 	void SetShaderMaterial(
 		std::string materialTag);
+	void SetShaderMaterial(
+		int materialHandle);
 
 public:
 
@@ -108,6 +408,21 @@ public:
 	void RenderScrapWood();
 	void RenderScene();
 
+	// enable/disable replaying the draws ordered front to back
+	// (enabled by default)
+	void SetFrontToBackSort(bool bEnabled);
+	// enable/disable the depth-only pass before the lit pass
+	// (disabled by default)
+	void SetDepthPrePass(bool bEnabled);
+
+	// number of draw calls the recorded scene submits per frame -
+	// for benchmark and statistics reporting
+	int GetDrawCallCount();
+
+	// instrumentation counters of the most recently rendered frame -
+	// draws issued, shader state transitions, and uniform updates
+	void GetFrameCounters(int& drawCalls, int& stateChanges, int& uniformUpdates);
+
 	// pre-set light sources for 3D scene
 	void SetupSceneLights();
 	// pre-define the object materials for lighting
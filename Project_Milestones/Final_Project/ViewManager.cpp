@@ -8,11 +8,14 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "ViewManager.h"
+#include "FrameProfiler.h"
 
 // GLM Math Header inclusions
 #include <glm/glm.hpp>
 #include <glm/gtx/transform.hpp>
-#include <glm/gtc/type_ptr.hpp>    
+#include <glm/gtc/type_ptr.hpp>
+
+#include <mutex>
 
 // declaration of the global variables and defines
 namespace
@@ -39,6 +42,64 @@ namespace
 	// if orthographic projection is on, this value will be
 	// true
 	bool bOrthographicProjection = false;
+
+	// tracks the held state of the profiler dump hotkey so one key
+	// press only writes one file
+	bool bProfilerDumpKeyDown = false;
+
+	// combined projection * view matrix computed for the current
+	// frame by PrepareSceneView()
+	glm::mat4 g_ViewProjectionMatrix = glm::mat4(1.0f);
+
+	// immutable per-frame view snapshot published by the input thread
+	// and consumed by the render thread
+	struct SCENE_VIEW_SNAPSHOT
+	{
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::vec3 viewPosition;
+	};
+
+	// the snapshot is handed over under a mutex - the input loop only
+	// publishes once a millisecond, so the lock is uncontended and a
+	// torn matrix read is impossible
+	SCENE_VIEW_SNAPSHOT gViewSnapshot;
+	std::mutex gViewSnapshotMutex;
+	bool gViewSnapshotValid = false;
+
+	// camera position of the snapshot most recently applied on the
+	// render thread - the render-side distance queries read this
+	// instead of the live camera the input thread is moving
+	glm::vec3 gAppliedViewPosition = glm::vec3(0.0f);
+
+	// matrices most recently uploaded to the shader - the camera sits
+	// still most frames, so the uploads only happen on change
+	bool gMatricesUploaded = false;
+	glm::mat4 gUploadedView;
+	glm::mat4 gUploadedProjection;
+	glm::vec3 gUploadedViewPosition;
+
+	// offscreen framebuffer for the render-scale feature - the scene
+	// is shaded into a fraction of the full-size attachments and then
+	// upscaled to the window with a linear blit
+	GLuint gRenderFBO = 0;
+	GLuint gRenderColorRBO = 0;
+	GLuint gRenderDepthRBO = 0;
+	bool gRenderFBOFailed = false;
+
+	// fraction of the window resolution the scene is shaded at
+	float gRenderScale = 1.0f;
+	const float g_RenderScaleMin = 0.5f;
+	const float g_RenderScaleMax = 1.0f;
+	const float g_RenderScaleStep = 0.05f;
+
+	// auto mode drops the render scale when the smoothed frame time
+	// exceeds the target and raises it again when there is headroom
+	bool gAutoRenderScale = false;
+	const double g_TargetFrameTime = 1.0 / 60.0;
+	double gFrameTimeAverage = 0.0;
+	double gLastRenderTime = 0.0;
+	int gScaleAdjustCooldown = 0;
 }
 
 /***********************************************************
@@ -59,6 +120,9 @@ ViewManager::ViewManager(
 	g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);
 	g_pCamera->Zoom = 80;
 	g_pCamera->MovementSpeed = 10;
+	// render-side queries see the starting position until the first
+	// snapshot is applied
+	gAppliedViewPosition = g_pCamera->Position;
 }
 
 /***********************************************************
@@ -68,6 +132,17 @@ ViewManager::ViewManager(
  ***********************************************************/
 ViewManager::~ViewManager()
 {
+	// free the offscreen framebuffer of the render-scale feature
+	if (gRenderFBO != 0)
+	{
+		glDeleteFramebuffers(1, &gRenderFBO);
+		glDeleteRenderbuffers(1, &gRenderColorRBO);
+		glDeleteRenderbuffers(1, &gRenderDepthRBO);
+		gRenderFBO = 0;
+		gRenderColorRBO = 0;
+		gRenderDepthRBO = 0;
+	}
+
 	// free up allocated memory
 	m_pShaderManager = NULL;
 	m_pWindow = NULL;
@@ -169,6 +244,206 @@ void ViewManager::Mouse_Scroll_Wheel_Callback(GLFWwindow* window, double xOffset
 	}
 }
 
+/***********************************************************
+ *  GetCameraPosition()
+ *
+ *  This method returns the camera position of the view
+ *  snapshot most recently applied on the render thread, for
+ *  distance based calculations like mesh level-of-detail
+ *  selection.  The live camera belongs to the input thread
+ *  and is never read here.
+ ***********************************************************/
+glm::vec3 ViewManager::GetCameraPosition()
+{
+	return gAppliedViewPosition;
+}
+
+/***********************************************************
+ *  GetViewProjectionMatrix()
+ *
+ *  This method returns the combined projection * view
+ *  matrix of the current frame for view-frustum visibility
+ *  tests against the scene objects.
+ ***********************************************************/
+glm::mat4 ViewManager::GetViewProjectionMatrix()
+{
+	return g_ViewProjectionMatrix;
+}
+
+/***********************************************************
+ *  BeginRender()
+ *
+ *  This method redirects the scene rendering into the
+ *  offscreen framebuffer, shading only the sub-viewport
+ *  that matches the current render scale.  The attachments
+ *  are allocated once at the full window size, so changing
+ *  the scale never reallocates them.
+ ***********************************************************/
+void ViewManager::BeginRender()
+{
+	// create the offscreen framebuffer on first use
+	if ((0 == gRenderFBO) && (gRenderFBOFailed == false))
+	{
+		glGenFramebuffers(1, &gRenderFBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, gRenderFBO);
+
+		glGenRenderbuffers(1, &gRenderColorRBO);
+		glBindRenderbuffer(GL_RENDERBUFFER, gRenderColorRBO);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8,
+			WINDOW_WIDTH, WINDOW_HEIGHT);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+			GL_RENDERBUFFER, gRenderColorRBO);
+
+		glGenRenderbuffers(1, &gRenderDepthRBO);
+		glBindRenderbuffer(GL_RENDERBUFFER, gRenderDepthRBO);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24,
+			WINDOW_WIDTH, WINDOW_HEIGHT);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+			GL_RENDERBUFFER, gRenderDepthRBO);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		// when the framebuffer cannot be completed the scene keeps
+		// rendering directly into the window at full resolution
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cout << "Could not create the render scale framebuffer, rendering at full resolution" << std::endl;
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glDeleteFramebuffers(1, &gRenderFBO);
+			glDeleteRenderbuffers(1, &gRenderColorRBO);
+			glDeleteRenderbuffers(1, &gRenderDepthRBO);
+			gRenderFBO = 0;
+			gRenderColorRBO = 0;
+			gRenderDepthRBO = 0;
+			gRenderFBOFailed = true;
+		}
+	}
+
+	if (0 == gRenderFBO)
+	{
+		return;
+	}
+
+	// shade only the corner of the attachments that matches the
+	// current render scale
+	int scaledWidth = (int)(WINDOW_WIDTH * gRenderScale);
+	int scaledHeight = (int)(WINDOW_HEIGHT * gRenderScale);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, gRenderFBO);
+	glViewport(0, 0, scaledWidth, scaledHeight);
+}
+
+/***********************************************************
+ *  EndRender()
+ *
+ *  This method upscales the shaded sub-viewport of the
+ *  offscreen framebuffer to the full window with a linear
+ *  blit, and adjusts the render scale from the smoothed
+ *  frame time when the auto mode is on.
+ ***********************************************************/
+void ViewManager::EndRender()
+{
+	if (gRenderFBO != 0)
+	{
+		int scaledWidth = (int)(WINDOW_WIDTH * gRenderScale);
+		int scaledHeight = (int)(WINDOW_HEIGHT * gRenderScale);
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, gRenderFBO);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(
+			0, 0, scaledWidth, scaledHeight,
+			0, 0, WINDOW_WIDTH, WINDOW_HEIGHT,
+			GL_COLOR_BUFFER_BIT, GL_LINEAR);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+	}
+
+	// smooth the frame time so single hitches do not flip the scale
+	double currentTime = glfwGetTime();
+	if (gLastRenderTime > 0.0)
+	{
+		double frameTime = currentTime - gLastRenderTime;
+		gFrameTimeAverage = (gFrameTimeAverage == 0.0) ?
+			frameTime : (gFrameTimeAverage * 0.9 + frameTime * 0.1);
+	}
+	gLastRenderTime = currentTime;
+
+	if ((gAutoRenderScale == false) || (gRenderFBO == 0))
+	{
+		return;
+	}
+
+	// hold the scale for a while after each change so the smoothed
+	// frame time can settle at the new resolution
+	if (gScaleAdjustCooldown > 0)
+	{
+		gScaleAdjustCooldown--;
+		return;
+	}
+
+	if ((gFrameTimeAverage > g_TargetFrameTime * 1.1) &&
+		(gRenderScale > g_RenderScaleMin))
+	{
+		SetRenderScale(gRenderScale - g_RenderScaleStep);
+		gScaleAdjustCooldown = 30;
+	}
+	else if ((gFrameTimeAverage < g_TargetFrameTime * 0.7) &&
+		(gRenderScale < g_RenderScaleMax))
+	{
+		SetRenderScale(gRenderScale + g_RenderScaleStep);
+		gScaleAdjustCooldown = 30;
+	}
+}
+
+/***********************************************************
+ *  SetRenderScale()
+ *
+ *  This method sets the fraction of the window resolution
+ *  the scene is shaded at.
+ ***********************************************************/
+void ViewManager::SetRenderScale(float scale)
+{
+	if (scale < g_RenderScaleMin)
+	{
+		scale = g_RenderScaleMin;
+	}
+	if (scale > g_RenderScaleMax)
+	{
+		scale = g_RenderScaleMax;
+	}
+	gRenderScale = scale;
+}
+
+/***********************************************************
+ *  SetAutoRenderScale()
+ *
+ *  This method enables/disables adjusting the render scale
+ *  automatically from the recent frame times.
+ ***********************************************************/
+void ViewManager::SetAutoRenderScale(bool bEnabled)
+{
+	gAutoRenderScale = bEnabled;
+	gScaleAdjustCooldown = 0;
+}
+
+/***********************************************************
+ *  SetCameraView()
+ *
+ *  This method places the scene camera at the passed in
+ *  position looking at the target point, so a scripted
+ *  path can drive the view instead of the input devices.
+ ***********************************************************/
+void ViewManager::SetCameraView(const glm::vec3& position, const glm::vec3& target)
+{
+	if (NULL == g_pCamera)
+	{
+		return;
+	}
+
+	g_pCamera->Position = position;
+	g_pCamera->Front = glm::normalize(target - position);
+	g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);
+}
+
 /***********************************************************
  *  ProcessKeyboardEvents()
  *
@@ -226,16 +501,33 @@ void ViewManager::ProcessKeyboardEvents()
 	{
 		bOrthographicProjection = true;
 	}
+
+	// Dump the collected frame timings when 'F9' is pressed - the
+	// write itself happens on the render thread at the end of the
+	// next frame, away from the sample windows it reads
+	if (glfwGetKey(m_pWindow, GLFW_KEY_F9) == GLFW_PRESS)
+	{
+		if (bProfilerDumpKeyDown == false)
+		{
+			FrameProfiler::RequestStatisticsDump("frame_profile.csv");
+			bProfilerDumpKeyDown = true;
+		}
+	}
+	else
+	{
+		bProfilerDumpKeyDown = false;
+	}
 }
 
 /***********************************************************
- *  PrepareSceneView()
+ *  UpdateSceneView()
  *
- *  This method is used for preparing the 3D scene by loading
- *  the shapes, textures in memory to support the 3D scene
- *  rendering.
+ *  This method processes the input events, moves the scene
+ *  camera, and publishes the resulting view snapshot for the
+ *  render thread.  It makes no GL calls, so it can run on
+ *  the input thread while the render thread draws.
  ***********************************************************/
-void ViewManager::PrepareSceneView()
+void ViewManager::UpdateSceneView()
 {
 	glm::mat4 view;
 	glm::mat4 projection;
@@ -245,7 +537,7 @@ void ViewManager::PrepareSceneView()
 	gDeltaTime = currentFrame - gLastFrame;
 	gLastFrame = currentFrame;
 
-	// Process any keyboard events that may be waiting in the 
+	// Process any keyboard events that may be waiting in the
 	// event queue
 	ProcessKeyboardEvents();
 
@@ -276,14 +568,81 @@ void ViewManager::PrepareSceneView()
 		projection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
 	}
 
+	// publish the snapshot for the render thread - the lock keeps the
+	// renderer from copying a half-written matrix
+	{
+		std::lock_guard<std::mutex> lock(gViewSnapshotMutex);
+		gViewSnapshot.view = view;
+		gViewSnapshot.projection = projection;
+		gViewSnapshot.viewPosition = g_pCamera->Position;
+		gViewSnapshotValid = true;
+	}
+}
+
+/***********************************************************
+ *  ApplySceneView()
+ *
+ *  This method takes the most recently published view
+ *  snapshot and sends its matrices into the shader - called
+ *  on the thread that owns the GL context.
+ ***********************************************************/
+void ViewManager::ApplySceneView()
+{
+	SCENE_VIEW_SNAPSHOT snapshot;
+
+	// copy the latest snapshot under the lock so the input thread can
+	// keep publishing - nothing to apply until the first one arrives
+	{
+		std::lock_guard<std::mutex> lock(gViewSnapshotMutex);
+		if (gViewSnapshotValid == false)
+		{
+			return;
+		}
+		snapshot = gViewSnapshot;
+	}
+
+	// keep the combined matrix and the camera position of this frame
+	// for the render-side visibility and level-of-detail queries
+	g_ViewProjectionMatrix = snapshot.projection * snapshot.view;
+	gAppliedViewPosition = snapshot.viewPosition;
+
 	// If the shader manager object is valid
 	if (NULL != m_pShaderManager)
 	{
-		// Set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ViewName, view);
-		// Set the projection matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ProjectionName, projection);
-		// Set the view position of the camera into the shader for proper rendering
-		m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
+		// Set the view matrix into the shader only when it has changed
+		if ((gMatricesUploaded == false) || (gUploadedView != snapshot.view))
+		{
+			m_pShaderManager->setMat4Value(g_ViewName, snapshot.view);
+			gUploadedView = snapshot.view;
+		}
+		// Set the projection matrix into the shader only when the
+		// perspective/orthographic toggle or the zoom has changed it
+		if ((gMatricesUploaded == false) || (gUploadedProjection != snapshot.projection))
+		{
+			m_pShaderManager->setMat4Value(g_ProjectionName, snapshot.projection);
+			gUploadedProjection = snapshot.projection;
+		}
+		// Set the view position of the camera into the shader only
+		// when the camera has moved
+		if ((gMatricesUploaded == false) || (gUploadedViewPosition != snapshot.viewPosition))
+		{
+			m_pShaderManager->setVec3Value("viewPosition", snapshot.viewPosition);
+			gUploadedViewPosition = snapshot.viewPosition;
+		}
+		gMatricesUploaded = true;
 	}
 }
+
+/***********************************************************
+ *  PrepareSceneView()
+ *
+ *  This method is used for preparing the 3D scene by loading
+ *  the shapes, textures in memory to support the 3D scene
+ *  rendering.  Single-threaded callers update and apply the
+ *  view in one step.
+ ***********************************************************/
+void ViewManager::PrepareSceneView()
+{
+	UpdateSceneView();
+	ApplySceneView();
+}
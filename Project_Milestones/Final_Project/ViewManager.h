@@ -30,6 +30,14 @@ public:
 	// mouse scroll wheel callback for zoom or movement speed adjustment
 	static void Mouse_Scroll_Wheel_Callback(GLFWwindow* window, double xOffset, double yOffset);
 
+	// current world position of the scene camera - for distance
+	// based calculations like mesh level-of-detail selection
+	static glm::vec3 GetCameraPosition();
+
+	// combined projection * view matrix of the current frame - for
+	// view-frustum visibility tests against the scene objects
+	static glm::mat4 GetViewProjectionMatrix();
+
 private:
 	// pointer to shader manager object
 	ShaderManager* m_pShaderManager;
@@ -43,6 +51,31 @@ public:
 	// create the initial OpenGL display window
 	GLFWwindow* CreateDisplayWindow(const char* windowTitle);
 
-	// prepare the conversion from 3D object display to 2D scene display
+	// prepare the conversion from 3D object display to 2D scene display -
+	// single-threaded callers update and apply the view in one step
 	void PrepareSceneView();
+
+	// process the input events and publish a new view snapshot - called
+	// on the input thread, makes no GL calls
+	void UpdateSceneView();
+
+	// send the most recently published view snapshot into the shader -
+	// called on the thread that owns the GL context
+	void ApplySceneView();
+
+	// place the scene camera at the passed in position looking at the
+	// target point - used to drive scripted camera paths
+	void SetCameraView(const glm::vec3& position, const glm::vec3& target);
+
+	// redirect the scene rendering into the offscreen framebuffer /
+	// upscale the offscreen image to the window - called around the
+	// scene rendering of each frame
+	void BeginRender();
+	void EndRender();
+
+	// fraction of the window resolution the scene is shaded at
+	void SetRenderScale(float scale);
+	// enable/disable adjusting the render scale automatically from
+	// the recent frame times (disabled by default)
+	void SetAutoRenderScale(bool bEnabled);
 };
@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////////
+// framepacer.cpp
+// ============
+// control the frame cadence of the render loop - vsync and rate limiting
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FramePacer.h"
+
+#include "GLFW/glfw3.h"     // GLFW library
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+// declaration of the global variables and defines
+namespace
+{
+	// the limiter sleeps until this long before the frame deadline and
+	// spins the rest - the OS sleep granularity makes sleeping all the
+	// way unreliable
+	const double g_SpinWindow = 0.002;
+
+	// seconds each frame may take under the active limit, 0.0 when the
+	// limiter is off
+	double g_FrameInterval = 0.0;
+
+	// deadline the next frame is released at
+	double g_NextFrameTime = 0.0;
+}
+
+/***********************************************************
+ *  SetSwapInterval()
+ *
+ *  This method sets the vsync swap interval explicitly.
+ ***********************************************************/
+void FramePacer::SetSwapInterval(int interval)
+{
+	glfwSwapInterval(interval);
+}
+
+/***********************************************************
+ *  SetAdaptiveVSync()
+ *
+ *  This method enables adaptive vsync when the platform
+ *  supports late swap tearing, and falls back to regular
+ *  vsync otherwise.
+ ***********************************************************/
+void FramePacer::SetAdaptiveVSync(bool bEnabled)
+{
+	if (bEnabled == false)
+	{
+		glfwSwapInterval(1);
+		return;
+	}
+
+	// a negative interval requests late swap tearing - only valid when
+	// the matching platform extension is present
+	if (glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+		glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+	{
+		glfwSwapInterval(-1);
+	}
+	else
+	{
+		std::cout << "Adaptive vsync not supported, using regular vsync" << std::endl;
+		glfwSwapInterval(1);
+	}
+}
+
+/***********************************************************
+ *  SetFrameRateLimit()
+ *
+ *  This method caps the frame rate at the passed in number
+ *  of frames per second - 0 turns the limiter off.
+ ***********************************************************/
+void FramePacer::SetFrameRateLimit(int framesPerSecond)
+{
+	if (framesPerSecond <= 0)
+	{
+		g_FrameInterval = 0.0;
+		g_NextFrameTime = 0.0;
+		return;
+	}
+
+	g_FrameInterval = 1.0 / (double)framesPerSecond;
+	g_NextFrameTime = glfwGetTime() + g_FrameInterval;
+}
+
+/***********************************************************
+ *  WaitForNextFrame()
+ *
+ *  This method blocks until the next frame of the active
+ *  limit may start.  The wait sleeps most of the interval
+ *  to keep the CPU cool and spins only the last couple of
+ *  milliseconds for a precise release time.
+ ***********************************************************/
+void FramePacer::WaitForNextFrame()
+{
+	if (g_FrameInterval <= 0.0)
+	{
+		return;
+	}
+
+	// sleep the bulk of the remaining time
+	double remaining = g_NextFrameTime - glfwGetTime();
+	if (remaining > g_SpinWindow)
+	{
+		std::this_thread::sleep_for(
+			std::chrono::duration<double>(remaining - g_SpinWindow));
+	}
+
+	// spin out the last stretch for a precise release
+	while (glfwGetTime() < g_NextFrameTime)
+	{
+	}
+
+	// schedule the next release on the fixed cadence; when a frame ran
+	// long the deadline restarts from now instead of bursting to catch
+	// up
+	g_NextFrameTime += g_FrameInterval;
+	if (g_NextFrameTime < glfwGetTime())
+	{
+		g_NextFrameTime = glfwGetTime() + g_FrameInterval;
+	}
+}
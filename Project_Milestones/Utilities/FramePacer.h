@@ -0,0 +1,31 @@
+///////////////////////////////////////////////////////////////////////////////
+// framepacer.h
+// ============
+// control the frame cadence of the render loop - vsync and rate limiting
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+class FramePacer
+{
+public:
+	// explicit vsync control - 0 disables the swap wait, 1 syncs to
+	// every display refresh, 2 to every other refresh
+	static void SetSwapInterval(int interval);
+
+	// adaptive vsync syncs to the refresh while the frame rate keeps
+	// up and tears instead of stuttering when it falls behind - falls
+	// back to regular vsync when the platform lacks the extension
+	static void SetAdaptiveVSync(bool bEnabled);
+
+	// optional frame-rate cap for thermally or power limited units -
+	// 0 turns the limiter off
+	static void SetFrameRateLimit(int framesPerSecond);
+
+	// block until the next frame of the configured cadence may start -
+	// called at the top of the render loop, before input processing
+	static void WaitForNextFrame();
+};
@@ -0,0 +1,364 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.cpp
+// ============
+// collect per-section CPU and GPU timings of the render frame
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// declaration of the global variables and defines
+namespace
+{
+	// number of frame samples kept per section for the rolling
+	// min/avg/p99 statistics
+	const int g_SampleWindow = 256;
+
+	// number of frames between the console summaries
+	const int g_ReportInterval = 600;
+
+	// timing data of one profiled frame section
+	struct PROFILE_SECTION
+	{
+		std::string name;
+		// double buffered timer queries - the query written in one
+		// frame is read back a frame later so the result collection
+		// never stalls the pipeline
+		GLuint gpuQuery[2];
+		bool bQueryIssued[2];
+		bool bQueryActive;
+		std::chrono::steady_clock::time_point cpuStart;
+		// rolling sample windows in milliseconds
+		std::vector<double> cpuSamples;
+		std::vector<double> gpuSamples;
+		int cpuNextSample;
+		int gpuNextSample;
+	};
+
+	// collection of the timings only happens while this is true
+	bool g_bEnabled = true;
+
+	// selects which timer query of each section is written this
+	// frame while the other one is read back
+	int g_FrameParity = 0;
+
+	// total number of profiled frames, used for the periodic report
+	int g_FrameCount = 0;
+
+	// index of the section opened by BeginSection(), -1 outside
+	int g_CurrentSection = -1;
+
+	// all sections seen so far, created on first use
+	std::vector<PROFILE_SECTION> g_Sections;
+
+	// CSV dump requested from another thread - the filename is only
+	// read after the flag is seen, so the release/acquire pair on the
+	// flag orders the accesses
+	std::string g_DumpFilename;
+	std::atomic<bool> g_bDumpRequested(false);
+
+	/***********************************************************
+	 *  FindSection()
+	 *
+	 *  This function returns the index of the named section,
+	 *  creating and initializing it on first use.
+	 ***********************************************************/
+	int FindSection(const char* sectionName)
+	{
+		for (int i = 0; i < (int)g_Sections.size(); i++)
+		{
+			if (g_Sections[i].name.compare(sectionName) == 0)
+			{
+				return i;
+			}
+		}
+
+		PROFILE_SECTION section;
+		section.name = sectionName;
+		glGenQueries(2, section.gpuQuery);
+		section.bQueryIssued[0] = false;
+		section.bQueryIssued[1] = false;
+		section.bQueryActive = false;
+		section.cpuNextSample = 0;
+		section.gpuNextSample = 0;
+		g_Sections.push_back(section);
+
+		return (int)g_Sections.size() - 1;
+	}
+
+	/***********************************************************
+	 *  AddSample()
+	 *
+	 *  This function appends one timing sample to a rolling
+	 *  window, overwriting the oldest sample once the window
+	 *  is full.
+	 ***********************************************************/
+	void AddSample(std::vector<double>& samples, int& nextSample, double value)
+	{
+		if ((int)samples.size() < g_SampleWindow)
+		{
+			samples.push_back(value);
+			return;
+		}
+
+		samples[nextSample] = value;
+		nextSample = (nextSample + 1) % g_SampleWindow;
+	}
+
+	/***********************************************************
+	 *  ComputeStatistics()
+	 *
+	 *  This function computes the min/avg/p99 values over one
+	 *  rolling sample window.
+	 ***********************************************************/
+	void ComputeStatistics(const std::vector<double>& samples,
+		double& minValue, double& avgValue, double& p99Value)
+	{
+		minValue = 0.0;
+		avgValue = 0.0;
+		p99Value = 0.0;
+
+		if (samples.size() == 0)
+		{
+			return;
+		}
+
+		std::vector<double> sorted = samples;
+		std::sort(sorted.begin(), sorted.end());
+
+		double total = 0.0;
+		for (int i = 0; i < (int)sorted.size(); i++)
+		{
+			total += sorted[i];
+		}
+
+		int p99Index = (int)((sorted.size() * 99) / 100);
+		if (p99Index >= (int)sorted.size())
+		{
+			p99Index = (int)sorted.size() - 1;
+		}
+
+		minValue = sorted[0];
+		avgValue = total / (double)sorted.size();
+		p99Value = sorted[p99Index];
+	}
+}
+
+/***********************************************************
+ *  SetEnabled()
+ *
+ *  This method turns the collection of the frame timings
+ *  on or off.
+ ***********************************************************/
+void FrameProfiler::SetEnabled(bool bEnabled)
+{
+	g_bEnabled = bEnabled;
+}
+
+/***********************************************************
+ *  IsEnabled()
+ *
+ *  This method returns whether timings are being collected.
+ ***********************************************************/
+bool FrameProfiler::IsEnabled()
+{
+	return g_bEnabled;
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method collects the GPU timer results issued in the
+ *  previous frame.  A result that is not yet available is
+ *  left pending rather than stalling the pipeline - that
+ *  section simply misses one GPU sample.
+ ***********************************************************/
+void FrameProfiler::BeginFrame()
+{
+	if (g_bEnabled == false)
+	{
+		return;
+	}
+
+	for (int i = 0; i < (int)g_Sections.size(); i++)
+	{
+		PROFILE_SECTION& section = g_Sections[i];
+
+		if (section.bQueryIssued[g_FrameParity] == false)
+		{
+			continue;
+		}
+
+		GLuint available = 0;
+		glGetQueryObjectuiv(section.gpuQuery[g_FrameParity],
+			GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available == 0)
+		{
+			continue;
+		}
+
+		GLuint64 elapsedNanoseconds = 0;
+		glGetQueryObjectui64v(section.gpuQuery[g_FrameParity],
+			GL_QUERY_RESULT, &elapsedNanoseconds);
+		AddSample(section.gpuSamples, section.gpuNextSample,
+			(double)elapsedNanoseconds / 1000000.0);
+		section.bQueryIssued[g_FrameParity] = false;
+	}
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method finishes the profiled frame and prints the
+ *  rolling statistics to the console at a fixed interval.
+ ***********************************************************/
+void FrameProfiler::EndFrame()
+{
+	if (g_bEnabled == false)
+	{
+		return;
+	}
+
+	g_FrameCount++;
+	// next frame writes the other query of each section while this
+	// one is read back
+	g_FrameParity = 1 - g_FrameParity;
+
+	// a dump requested from another thread is written here, where no
+	// section is mutating the sample windows
+	if (g_bDumpRequested.exchange(false, std::memory_order_acquire) == true)
+	{
+		DumpStatisticsCSV(g_DumpFilename.c_str());
+	}
+
+	if ((g_FrameCount % g_ReportInterval) != 0)
+	{
+		return;
+	}
+
+	std::cout << "Frame profile after " << g_FrameCount << " frames (ms):" << std::endl;
+	for (int i = 0; i < (int)g_Sections.size(); i++)
+	{
+		double cpuMin, cpuAvg, cpuP99;
+		double gpuMin, gpuAvg, gpuP99;
+
+		ComputeStatistics(g_Sections[i].cpuSamples, cpuMin, cpuAvg, cpuP99);
+		ComputeStatistics(g_Sections[i].gpuSamples, gpuMin, gpuAvg, gpuP99);
+
+		printf("  %-20s cpu %6.3f/%6.3f/%6.3f  gpu %6.3f/%6.3f/%6.3f\n",
+			g_Sections[i].name.c_str(),
+			cpuMin, cpuAvg, cpuP99, gpuMin, gpuAvg, gpuP99);
+	}
+}
+
+/***********************************************************
+ *  BeginSection()
+ *
+ *  This method opens the named section - the CPU timestamp
+ *  is taken and a GL_TIME_ELAPSED query is started unless
+ *  the query of this frame's slot is still pending.
+ ***********************************************************/
+void FrameProfiler::BeginSection(const char* sectionName)
+{
+	if (g_bEnabled == false)
+	{
+		return;
+	}
+
+	g_CurrentSection = FindSection(sectionName);
+	PROFILE_SECTION& section = g_Sections[g_CurrentSection];
+
+	section.cpuStart = std::chrono::steady_clock::now();
+
+	if (section.bQueryIssued[g_FrameParity] == false)
+	{
+		glBeginQuery(GL_TIME_ELAPSED, section.gpuQuery[g_FrameParity]);
+		section.bQueryActive = true;
+	}
+}
+
+/***********************************************************
+ *  EndSection()
+ *
+ *  This method closes the currently open section and stores
+ *  its CPU timing sample.
+ ***********************************************************/
+void FrameProfiler::EndSection()
+{
+	if ((g_bEnabled == false) || (g_CurrentSection < 0))
+	{
+		return;
+	}
+
+	PROFILE_SECTION& section = g_Sections[g_CurrentSection];
+
+	std::chrono::duration<double, std::milli> cpuElapsed =
+		std::chrono::steady_clock::now() - section.cpuStart;
+	AddSample(section.cpuSamples, section.cpuNextSample, cpuElapsed.count());
+
+	if (section.bQueryActive == true)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		section.bQueryIssued[g_FrameParity] = true;
+		section.bQueryActive = false;
+	}
+
+	g_CurrentSection = -1;
+}
+
+/***********************************************************
+ *  DumpStatisticsCSV()
+ *
+ *  This method writes the rolling statistics of every
+ *  section into a CSV file for offline analysis.
+ ***********************************************************/
+bool FrameProfiler::DumpStatisticsCSV(const char* filename)
+{
+	FILE* pCSVFile = fopen(filename, "w");
+	if (NULL == pCSVFile)
+	{
+		std::cout << "Could not write the frame profile file:" << filename << std::endl;
+		return false;
+	}
+
+	fprintf(pCSVFile, "section,cpu_min_ms,cpu_avg_ms,cpu_p99_ms,gpu_min_ms,gpu_avg_ms,gpu_p99_ms\n");
+	for (int i = 0; i < (int)g_Sections.size(); i++)
+	{
+		double cpuMin, cpuAvg, cpuP99;
+		double gpuMin, gpuAvg, gpuP99;
+
+		ComputeStatistics(g_Sections[i].cpuSamples, cpuMin, cpuAvg, cpuP99);
+		ComputeStatistics(g_Sections[i].gpuSamples, gpuMin, gpuAvg, gpuP99);
+
+		fprintf(pCSVFile, "%s,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+			g_Sections[i].name.c_str(),
+			cpuMin, cpuAvg, cpuP99, gpuMin, gpuAvg, gpuP99);
+	}
+	fclose(pCSVFile);
+
+	std::cout << "Saved the frame profile file:" << filename << std::endl;
+	return true;
+}
+
+/***********************************************************
+ *  RequestStatisticsDump()
+ *
+ *  This method requests the CSV dump from another thread -
+ *  EndFrame() performs the write on the frame thread, where
+ *  the sample windows are not being mutated.
+ ***********************************************************/
+void FrameProfiler::RequestStatisticsDump(const char* filename)
+{
+	g_DumpFilename = filename;
+	g_bDumpRequested.store(true, std::memory_order_release);
+}
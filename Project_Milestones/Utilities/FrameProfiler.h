@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.h
+// ============
+// collect per-section CPU and GPU timings of the render frame
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>        // GLEW library
+
+class FrameProfiler
+{
+public:
+	// turn the collection of the timings on/off - sections are not
+	// timed while the profiler is disabled
+	static void SetEnabled(bool bEnabled);
+	static bool IsEnabled();
+
+	// mark the start/end of the current frame - the timer query
+	// results of the previous frame are collected at the start and
+	// a console summary is printed periodically at the end
+	static void BeginFrame();
+	static void EndFrame();
+
+	// bracket one named section of the frame with a CPU timestamp
+	// pair and a GL_TIME_ELAPSED timer query - sections must not
+	// overlap each other
+	static void BeginSection(const char* sectionName);
+	static void EndSection();
+
+	// write the rolling min/avg/p99 statistics of every section
+	// into a CSV file - must be called on the thread that runs the
+	// frame, since it reads the sample windows that thread fills
+	static bool DumpStatisticsCSV(const char* filename);
+
+	// request the CSV dump from another thread - the write happens
+	// at the end of the next profiled frame
+	static void RequestStatisticsDump(const char* filename);
+};
@@ -23,6 +23,137 @@ using namespace std;
 
 #include "ShaderManager.h"
 
+// declaration of the global variables and defines
+namespace
+{
+	// file extension appended to the vertex shader filename to name the
+	// cache file holding the linked program binary of a previous run
+	const char* g_ProgramCacheExtension = ".progbin";
+
+	// layout of the header at the front of a program cache file
+	struct PROGRAM_CACHE_HEADER
+	{
+		unsigned int magic;
+		unsigned long long sourceHash;
+		GLenum binaryFormat;
+		GLsizei binaryLength;
+	};
+	// "PBC1" - bump when the header layout changes
+	const unsigned int g_ProgramCacheMagic = 0x31434250;
+
+	// folds the passed in string into an FNV-1a hash value
+	void HashAppend(unsigned long long& hash, const char* pData)
+	{
+		if (NULL == pData)
+		{
+			return;
+		}
+		while (*pData != 0)
+		{
+			hash ^= (unsigned char)(*pData++);
+			hash *= 1099511628211ULL;
+		}
+	}
+
+	// tries to create a program from the binary stored in the cache
+	// file - returns 0 when there is no usable cached binary
+	GLuint LoadProgramBinaryCache(const std::string& filename, unsigned long long sourceHash)
+	{
+		// program binary support is optional - a driver that exposes no
+		// binary formats cannot load one either
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		if (formatCount <= 0)
+		{
+			return 0;
+		}
+
+		FILE* pCacheFile = fopen(filename.c_str(), "rb");
+		if (NULL == pCacheFile)
+		{
+			return 0;
+		}
+
+		// the cached binary is only usable when it was saved from the
+		// same shader sources on the same driver
+		PROGRAM_CACHE_HEADER header;
+		if ((fread(&header, sizeof(header), 1, pCacheFile) != 1) ||
+			(header.magic != g_ProgramCacheMagic) ||
+			(header.sourceHash != sourceHash) ||
+			(header.binaryLength <= 0))
+		{
+			fclose(pCacheFile);
+			return 0;
+		}
+
+		std::vector<char> binaryData(header.binaryLength);
+		if (fread(&binaryData[0], 1, header.binaryLength, pCacheFile) != (size_t)header.binaryLength)
+		{
+			fclose(pCacheFile);
+			return 0;
+		}
+		fclose(pCacheFile);
+
+		GLuint programID = glCreateProgram();
+		glProgramBinary(programID, header.binaryFormat, &binaryData[0], header.binaryLength);
+
+		// the driver may still reject the binary even when the key
+		// matched - the caller falls back to source compilation
+		GLint result = GL_FALSE;
+		glGetProgramiv(programID, GL_LINK_STATUS, &result);
+		if (result != GL_TRUE)
+		{
+			glDeleteProgram(programID);
+			return 0;
+		}
+
+		return programID;
+	}
+
+	// retrieves the binary of the freshly linked program and stores it
+	// into the cache file for the next launch
+	void SaveProgramBinaryCache(const std::string& filename, unsigned long long sourceHash, GLuint programID)
+	{
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		if (formatCount <= 0)
+		{
+			return;
+		}
+
+		GLint binaryLength = 0;
+		glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+		if (binaryLength <= 0)
+		{
+			return;
+		}
+
+		std::vector<char> binaryData(binaryLength);
+		GLenum binaryFormat = 0;
+		GLsizei retrievedLength = 0;
+		glGetProgramBinary(programID, binaryLength, &retrievedLength, &binaryFormat, &binaryData[0]);
+		if (retrievedLength <= 0)
+		{
+			return;
+		}
+
+		PROGRAM_CACHE_HEADER header;
+		header.magic = g_ProgramCacheMagic;
+		header.sourceHash = sourceHash;
+		header.binaryFormat = binaryFormat;
+		header.binaryLength = retrievedLength;
+
+		FILE* pCacheFile = fopen(filename.c_str(), "wb");
+		if (NULL == pCacheFile)
+		{
+			return;
+		}
+		fwrite(&header, sizeof(header), 1, pCacheFile);
+		fwrite(&binaryData[0], 1, retrievedLength, pCacheFile);
+		fclose(pCacheFile);
+	}
+}
+
 /***********************************************************
  *  LoadShaders()
  *
@@ -59,6 +190,29 @@ GLuint ShaderManager::LoadShaders(const char * vertex_file_path,const char * fra
 		FragmentShaderStream.close();
 	}
 
+	// Hash the shader sources and the driver identification strings -
+	// a changed shader file or a driver update must invalidate any
+	// cached program binary
+	unsigned long long SourceHash = 14695981039346656037ULL;
+	HashAppend(SourceHash, VertexShaderCode.c_str());
+	HashAppend(SourceHash, FragmentShaderCode.c_str());
+	HashAppend(SourceHash, (const char*)glGetString(GL_RENDERER));
+	HashAppend(SourceHash, (const char*)glGetString(GL_VERSION));
+
+	// Try the program binary saved by a previous run - a hit skips the
+	// compile and link of both shaders entirely
+	std::string CacheFilename = std::string(vertex_file_path) + g_ProgramCacheExtension;
+	GLuint CachedProgramID = LoadProgramBinaryCache(CacheFilename, SourceHash);
+	if (CachedProgramID != 0)
+	{
+		printf("Loaded cached shader program binary : %s\n", CacheFilename.c_str());
+		glDeleteShader(VertexShaderID);
+		glDeleteShader(FragmentShaderID);
+		m_programID = CachedProgramID;
+		m_uniformLocations.clear();
+		return CachedProgramID;
+	}
+
 	GLint Result = GL_FALSE;
 	int InfoLogLength;
 
@@ -103,6 +257,9 @@ GLuint ShaderManager::LoadShaders(const char * vertex_file_path,const char * fra
 	m_programID = ProgramID;
 	glAttachShader(ProgramID, VertexShaderID);
 	glAttachShader(ProgramID, FragmentShaderID);
+	// ask the driver to keep the binary of the program retrievable so
+	// it can be cached for the next launch
+	glProgramParameteri(ProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 	glLinkProgram(ProgramID);
 
 	// Check the program
@@ -115,7 +272,18 @@ GLuint ShaderManager::LoadShaders(const char * vertex_file_path,const char * fra
 	}
 
 	printf("success\n");
-	
+
+	// store the binary of the linked program so the next launch can
+	// skip the source compilation
+	if (GL_TRUE == Result)
+	{
+		SaveProgramBinaryCache(CacheFilename, SourceHash, ProgramID);
+	}
+
+	// any uniform locations cached for a previously linked program
+	// are no longer valid
+	m_uniformLocations.clear();
+
 	glDetachShader(ProgramID, VertexShaderID);
 	glDetachShader(ProgramID, FragmentShaderID);
 	
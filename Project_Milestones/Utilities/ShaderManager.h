@@ -19,14 +19,21 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <map>
 
 class ShaderManager
 {
 public:
 	unsigned int m_programID;
-	
+
+	// opaque handle for a resolved uniform location - resolve the
+	// handle once with GetUniformHandle() and pass it to the set*
+	// overloads below to avoid a glGetUniformLocation call and a
+	// string lookup on every update
+	typedef GLint UniformHandle;
+
 	GLuint LoadShaders(
-		const char* vertex_file_path, 
+		const char* vertex_file_path,
 		const char* fragment_file_path);
 
 	// activate the shader
@@ -36,77 +43,132 @@ public:
 		glUseProgram(m_programID);
 	}
 
-	// utility uniform functions
+	// resolve the location of the named uniform - the result is cached
+	// so repeated calls with the same name do not go back to the driver
+	// ------------------------------------------------------------------------
+	inline UniformHandle GetUniformHandle(const std::string &name) const
+	{
+		std::map<std::string, GLint>::const_iterator iter = m_uniformLocations.find(name);
+		if (iter != m_uniformLocations.end())
+		{
+			return(iter->second);
+		}
+
+		GLint location = glGetUniformLocation(m_programID, name.c_str());
+		m_uniformLocations[name] = location;
+		return(location);
+	}
+
+	// utility uniform functions - the named versions resolve the
+	// location through the cache, the handle versions are a single
+	// glUniform* call for per-frame hot paths
 	// ------------------------------------------------------------------------
 	inline void setBoolValue(const std::string &name, bool value) const
 	{
-		glUniform1i(glGetUniformLocation(m_programID, name.c_str()), (int)value);
+		glUniform1i(GetUniformHandle(name), (int)value);
+	}
+	inline void setBoolValue(UniformHandle handle, bool value) const
+	{
+		glUniform1i(handle, (int)value);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setIntValue(const std::string &name, int value) const
 	{
-		glUniform1i(glGetUniformLocation(m_programID, name.c_str()), value);
+		glUniform1i(GetUniformHandle(name), value);
+	}
+	inline void setIntValue(UniformHandle handle, int value) const
+	{
+		glUniform1i(handle, value);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setFloatValue(const std::string &name, float value) const
 	{
-		glUniform1f(glGetUniformLocation(m_programID, name.c_str()), value);
+		glUniform1f(GetUniformHandle(name), value);
+	}
+	inline void setFloatValue(UniformHandle handle, float value) const
+	{
+		glUniform1f(handle, value);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setVec2Value(const std::string &name, const glm::vec2 &value) const
 	{
-		glUniform2fv(glGetUniformLocation(m_programID, name.c_str()), 1, &value[0]);
+		glUniform2fv(GetUniformHandle(name), 1, &value[0]);
+	}
+	inline void setVec2Value(UniformHandle handle, const glm::vec2 &value) const
+	{
+		glUniform2fv(handle, 1, &value[0]);
 	}
 
 	inline void setVec2Value(const std::string &name, float x, float y) const
 	{
-		glUniform2f(glGetUniformLocation(m_programID, name.c_str()), x, y);
+		glUniform2f(GetUniformHandle(name), x, y);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setVec3Value(const std::string &name, const glm::vec3 &value) const
 	{
-		glUniform3fv(glGetUniformLocation(m_programID, name.c_str()), 1, &value[0]);
+		glUniform3fv(GetUniformHandle(name), 1, &value[0]);
+	}
+	inline void setVec3Value(UniformHandle handle, const glm::vec3 &value) const
+	{
+		glUniform3fv(handle, 1, &value[0]);
 	}
 	inline void setVec3Value(const std::string &name, float x, float y, float z) const
 	{
-		glUniform3f(glGetUniformLocation(m_programID, name.c_str()), x, y, z);
+		glUniform3f(GetUniformHandle(name), x, y, z);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setVec4Value(const std::string &name, const glm::vec4 &value) const
 	{
-		glUniform4fv(glGetUniformLocation(m_programID, name.c_str()), 1, &value[0]);
+		glUniform4fv(GetUniformHandle(name), 1, &value[0]);
+	}
+	inline void setVec4Value(UniformHandle handle, const glm::vec4 &value) const
+	{
+		glUniform4fv(handle, 1, &value[0]);
 	}
 	inline void setVec4Value(const std::string &name, float x, float y, float z, float w)
 	{
-		glUniform4f(glGetUniformLocation(m_programID, name.c_str()), x, y, z, w);
+		glUniform4f(GetUniformHandle(name), x, y, z, w);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setMat2Value(const std::string &name, const glm::mat2 &mat) const
 	{
-		glUniformMatrix2fv(glGetUniformLocation(m_programID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+		glUniformMatrix2fv(GetUniformHandle(name), 1, GL_FALSE, &mat[0][0]);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setMat3Value(const std::string &name, const glm::mat3 &mat) const
 	{
-		glUniformMatrix3fv(glGetUniformLocation(m_programID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+		glUniformMatrix3fv(GetUniformHandle(name), 1, GL_FALSE, &mat[0][0]);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setMat4Value(const std::string &name, const glm::mat4 &mat) const
 	{
-		glUniformMatrix4fv(glGetUniformLocation(m_programID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
+		glUniformMatrix4fv(GetUniformHandle(name), 1, GL_FALSE, glm::value_ptr(mat));
+	}
+	inline void setMat4Value(UniformHandle handle, const glm::mat4 &mat) const
+	{
+		glUniformMatrix4fv(handle, 1, GL_FALSE, glm::value_ptr(mat));
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setSampler2DValue(const std::string& name, const int &value) const
 	{
-		glUniform1i(glGetUniformLocation(m_programID, name.c_str()), value);
+		glUniform1i(GetUniformHandle(name), value);
 	}
+	inline void setSampler2DValue(UniformHandle handle, const int &value) const
+	{
+		glUniform1i(handle, value);
+	}
+
+private:
+	// cache of resolved uniform locations for the current program -
+	// cleared whenever a new program is linked in LoadShaders()
+	mutable std::map<std::string, GLint> m_uniformLocations;
 };
@@ -79,7 +79,19 @@ public:
     // returns the view matrix calculated using Euler Angles and the LookAt Matrix
     glm::mat4 GetViewMatrix() const
     {
-        return glm::lookAt(Position, Position + Front, Up);
+        // the camera attributes are public and written directly by the
+        // callers, so the cached matrix is validated against the inputs
+        // it was computed from - glm::lookAt only runs when one of them
+        // has actually changed since the last call
+        if (!viewCacheValid || cachedPosition != Position || cachedFront != Front || cachedUp != Up)
+        {
+            cachedViewMatrix = glm::lookAt(Position, Position + Front, Up);
+            cachedPosition = Position;
+            cachedFront = Front;
+            cachedUp = Up;
+            viewCacheValid = true;
+        }
+        return cachedViewMatrix;
     }
 
     // processes input received from any keyboard-like input system. Accepts input parameter in the form of camera defined ENUM (to abstract it from windowing systems)
@@ -133,6 +145,14 @@ public:
     }
 
 private:
+    // cached view matrix and the attribute values it was computed from -
+    // mutable so the const GetViewMatrix can refresh them
+    mutable glm::mat4 cachedViewMatrix;
+    mutable glm::vec3 cachedPosition;
+    mutable glm::vec3 cachedFront;
+    mutable glm::vec3 cachedUp;
+    mutable bool viewCacheValid = false;
+
     // calculates the front vector from the Camera's (updated) Euler Angles
     void updateCameraVectors()
     {